@@ -6,6 +6,7 @@
 #define MAX_DISK_SIZE (16384 + 1)
 #define MAX_REQUEST_NUM (30000000 + 1)
 #define MAX_OBJECT_NUM (100000 + 1)
+#define MAX_OBJECT_SIZE 5
 #define REP_NUM 3
 #define FRE_PER_SLICING (1800)
 #define EXTRA_TIME (105)
@@ -1,17 +1,31 @@
 #include "disk_head_manager.h"
 #include "disk_manager.h"
+#include "fast_io.h"
+#include "read_cost.h"
 #include <algorithm>
+#include <charconv>
 #include <climits>
 #include <iostream>
-#include <sstream>
 #include <cmath>
 
 DiskHeadManager::DiskHeadManager(int disks, int units, int maxTokens, DiskManager& dm) 
-    : diskCount(disks), unitCount(units), maxTokensPerSlice(maxTokens), diskManager(dm) {
+    : diskCount(disks), unitCount(units), maxTokensPerSlice(maxTokens), diskManager(dm),
+      workerPool(nullptr), plannerType(PLANNER_GREEDY), jumpDensityMargin(0),
+      readDensityWindow(DEFAULT_READ_DENSITY_WINDOW), softDemandWeight(0) {
     // 初始化每个磁盘的磁头状态和任务队列
     headStates.resize(disks + 1);  // 索引从1开始
-    taskQueues.resize(disks + 1);
+    headPlans.resize(disks + 1);
+    executedReads.resize(disks + 1);
+    horizonPlanners.resize(disks + 1);
     diskReadUnits.resize(disks + 1);
+    for (int i = 1; i <= disks; i++) {
+        diskReadUnits[i].init(units);
+        // 一个时间片最多 G 个动作，读取最多 G/16 次
+        headPlans[i].actions.reserve(maxTokens + 16);
+        headPlans[i].actions.assign(1, '#');
+        headPlans[i].readPositions.reserve(maxTokens / 16 + 1);
+        executedReads[i].reserve(maxTokens / 16 + 1);
+    }
 }
 
 void DiskHeadManager::resetTimeSlice() {
@@ -20,7 +34,7 @@ void DiskHeadManager::resetTimeSlice() {
     generateTasks();
 }
 
-bool DiskHeadManager::addReadRequest(int diskId, int unitPosition) {
+bool DiskHeadManager::addReadRequest(int diskId, int unitPosition, int count) {
 #ifndef NDEBUG
     // 检查参数的有效性
     if (diskId < 1 || diskId > diskCount || 
@@ -29,8 +43,8 @@ bool DiskHeadManager::addReadRequest(int diskId, int unitPosition) {
     }
 #endif
     
-    // 添加读取请求
-    diskReadUnits[diskId].insert(unitPosition);
+    // 增加单元的需求数
+    diskReadUnits[diskId].addDemand(unitPosition, count);
     return true;
 }
 
@@ -47,20 +61,20 @@ bool DiskHeadManager::addReadRequests(int diskId, const std::vector<int>& unitPo
         if (pos < 1 || pos > unitCount) {
             success = false;
         } else {
-            diskReadUnits[diskId].insert(pos);
+            diskReadUnits[diskId].addDemand(pos);
         }
     }
     return success;
 #else
     // 直接添加所有读取请求
     for (int pos : unitPositions) {
-        diskReadUnits[diskId].insert(pos);
+        diskReadUnits[diskId].addDemand(pos);
     }
     return true;
 #endif
 }
 
-bool DiskHeadManager::cancelReadRequest(int diskId, int unitPosition) {
+bool DiskHeadManager::cancelReadRequest(int diskId, int unitPosition, int count) {
 #ifndef NDEBUG
     // 检查参数的有效性
     if (diskId < 1 || diskId > diskCount || 
@@ -69,14 +83,8 @@ bool DiskHeadManager::cancelReadRequest(int diskId, int unitPosition) {
     }
 #endif
     
-    // 如果存在该读取请求，则移除
-    auto& readUnits = diskReadUnits[diskId];
-    auto it = readUnits.find(unitPosition);
-    if (it != readUnits.end()) {
-        readUnits.erase(it);
-        return true;
-    }
-    return false;
+    // 减少单元的需求数，减到0时不再读取
+    return diskReadUnits[diskId].releaseDemand(unitPosition, count);
 }
 
 bool DiskHeadManager::cancelReadRequests(int diskId, const std::vector<int>& unitPositions) {
@@ -94,14 +102,41 @@ bool DiskHeadManager::cancelReadRequests(int diskId, const std::vector<int>& uni
     }
 #endif
 
-    // 移除所有读取请求
+    // 每个单元的需求数减一
     for (int pos : unitPositions) {
-        diskReadUnits[diskId].erase(pos);
+        diskReadUnits[diskId].releaseDemand(pos);
     }
 
     return true;
 }
 
+void DiskHeadManager::addSoftReadRequest(int diskId, int unitPosition, int count) {
+#ifndef NDEBUG
+    if (diskId < 1 || diskId > diskCount || unitPosition < 1 || unitPosition > unitCount) {
+        return;
+    }
+#endif
+    diskReadUnits[diskId].addSoftDemand(unitPosition, count);
+}
+
+void DiskHeadManager::cancelSoftReadRequest(int diskId, int unitPosition, int count) {
+#ifndef NDEBUG
+    if (diskId < 1 || diskId > diskCount || unitPosition < 1 || unitPosition > unitCount) {
+        return;
+    }
+#endif
+    diskReadUnits[diskId].releaseSoftDemand(unitPosition, count);
+}
+
+void DiskHeadManager::withdrawReadRequest(int diskId, int unitPosition) {
+#ifndef NDEBUG
+    if (diskId < 1 || diskId > diskCount || unitPosition < 1 || unitPosition > unitCount) {
+        return;
+    }
+#endif
+    diskReadUnits[diskId].erase(unitPosition);
+}
+
 void DiskHeadManager::cancelAllReadRequests(int diskId) {
 #ifndef NDEBUG
     // 检查磁盘ID的有效性
@@ -118,7 +153,12 @@ void DiskHeadManager::cancelAllReadRequests(int diskId) {
 }
 
 void DiskHeadManager::generateTasks() {
-    // 为每个磁盘生成任务
+    // 为每个磁盘生成任务，各磁盘只访问自己的状态，可以并行
+    if (workerPool != nullptr) {
+        auto planDisk = [this](int diskId) { generateTasksForDisk(diskId); };
+        workerPool->parallelFor(1, diskCount + 1, planDisk);
+        return;
+    }
     for (int diskId = 1; diskId <= diskCount; diskId++) {
         generateTasksForDisk(diskId);
     }
@@ -132,6 +172,8 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
     if (diskReadUnits[diskId].empty()) {
         return;
     }
+    HeadPlan& plan = headPlans[diskId];
+    plan.actions.clear();
     
     // 获取当前磁头位置和可用令牌数
     int currentPos = headStates[diskId].currentPosition;
@@ -143,9 +185,14 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
         if (nextUnit != -1 && nextUnit != currentPos) {
             int passCount = calculatePassCount(currentPos, nextUnit);
             if (passCount + 64 > availableTokens) {
+                // 跳跃消耗整个时间片，选择读取密度最高的窗口作为目标
+                nextUnit = selectJumpTarget(diskId, currentPos, nextUnit);
+
                 // 使用JUMP操作（只能在时间片开始时执行）
-                HeadTask jumpTask(ACTION_JUMP, nextUnit);
-                taskQueues[diskId].push(jumpTask);
+                char digits[16];
+                char* digitsEnd = std::to_chars(digits, digits + sizeof(digits), nextUnit).ptr;
+                plan.actions.append("j ", 2);
+                plan.actions.append(digits, digitsEnd - digits);
 
                 currentPos = nextUnit;
                 headStates[diskId].lastAction = ACTION_JUMP;
@@ -157,6 +204,23 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
         }
     }
     
+    // 使用DP规划器
+    if (plannerType == PLANNER_HORIZON_DP) {
+        HeadState& state = headStates[diskId];
+        int lastReadCost = state.lastAction == ACTION_READ ? state.lastTokenCost : 0;
+        int actionCount = static_cast<int>(plan.actions.size());
+        currentPos = horizonPlanners[diskId].plan(diskReadUnits[diskId], unitCount, currentPos, lastReadCost,
+                                                  availableTokens, maxTokensPerSlice, getSoftReadBonus(),
+                                                  plan.actions, plan.readPositions);
+        if (static_cast<int>(plan.actions.size()) > actionCount) {
+            state.lastAction = lastReadCost > 0 ? ACTION_READ : ACTION_PASS;
+            state.lastTokenCost = lastReadCost > 0 ? lastReadCost : 1;
+        }
+        state.currentPosition = currentPos;
+        plan.actions.push_back('#');
+        return;
+    }
+
     // 循环生成任务，直到没有更多需要读取的单元或无法生成有效任务
     while (!diskReadUnits[diskId].empty() && availableTokens > 0) {
         // 找到下一个需要读取的单元
@@ -178,8 +242,8 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
             }
             
             // 添加读取任务
-            HeadTask readTask(ACTION_READ, nextUnit);
-            taskQueues[diskId].push(readTask);
+            plan.actions.push_back('r');
+            plan.readPositions.push_back(nextUnit);
 
             // 更新可用令牌和当前位置
             availableTokens -= readCost;
@@ -209,54 +273,41 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
                 totalPassPlanCost = availableTokens + 64;
             }
             
-            // 方案2：连续使用READ移动passCount+1次
-            int totalReadCost = 0;
-            int possibleReadSteps = 0; // 当前时间片可以完成的READ步数
-            int lastCost = headStates[diskId].lastTokenCost;
-            bool readNeedsNextSlice = false;
-            
-            // 模拟连续READ操作，计算可以完成的步数和总损失
-            int tempAvailableTokens = availableTokens;
-            for (int i = 0; i <= passCount; i++) {
-                int cost = std::max(16, (int)std::ceil(lastCost * 0.8));
-                
-                if (tempAvailableTokens >= cost) {
-                    totalReadCost += cost;
-                    tempAvailableTokens -= cost;
-                    lastCost = cost;
-                    possibleReadSteps++;
-                    if (totalReadCost > totalPassPlanCost) {
-                        break;
-                    }
-                } else {
-                    readNeedsNextSlice = true;
-                    break;
-                }
+            // 连续READ会顺带读取途中只有软需求的单元，其收益计入READ方案
+            int softBonus = 0;
+            if (getSoftReadBonus() > 0) {
+                softBonus = getSoftReadBonus() * diskReadUnits[diskId].countSoftCircular(currentPos, passCount);
             }
+
+            // 方案2：连续使用READ移动passCount+1次
+            // 当前时间片可以完成的READ步数受可用令牌限制，且总损失（扣除软需求收益）超过PASS方案后不再继续，均查表得到
+            int readState = readStateAfterCost(headStates[diskId].lastTokenCost);
+            int readSteps = passCount + 1;
+            int fitSteps = maxReadsWithin(readState, availableTokens);
+            int exceedSteps = minReadsExceeding(readState, totalPassPlanCost + softBonus);
+            int possibleReadSteps = std::min({readSteps, fitSteps, exceedSteps}); // 当前时间片可以完成的READ步数
+            bool readNeedsNextSlice = fitSteps < readSteps && fitSteps < exceedSteps;
+            int totalReadCost = readChainCost(readState, possibleReadSteps);
+            int lastCost = possibleReadSteps > 0
+                ? READ_COST_BY_STATE[readStateAfter(readState, possibleReadSteps - 1)]
+                : headStates[diskId].lastTokenCost;
             int totalReadPlanCost = totalReadCost;
             // 如果READ方案需要下一时间片，计算额外损失
             if (readNeedsNextSlice) {
-                // 下一时间片继续使用当前计算的lastCost递减，而不是重新从64开始
-                int remainingSteps = passCount + 1 - possibleReadSteps;
-                // 使用当前时间片最后一次READ操作的成本作为起点继续计算
-                int nextLastCost = lastCost;
-                int nextSliceCost = 0;
-                
-                for (int i = 0; i < remainingSteps; i++) {
-                    int stepCost = std::max(16, (int)std::ceil(nextLastCost * 0.8));
-                    nextSliceCost += stepCost;
-                    nextLastCost = stepCost;
-                }
+                // 下一时间片继续当前的衰减状态，而不是重新从64开始
+                int remainingSteps = readSteps - possibleReadSteps;
+                int nextSliceCost = readChainCost(readStateAfter(readState, possibleReadSteps), remainingSteps);
                 totalReadPlanCost = availableTokens + nextSliceCost;
             }
+            totalReadPlanCost -= softBonus;
             
             // 比较总损失，选择最优方案
-            if (totalReadPlanCost < totalPassPlanCost || isReadDensityHigh(diskId, currentPos, 6)) {
+            if (totalReadPlanCost < totalPassPlanCost || isReadDensityHigh(diskId, currentPos, readDensityWindow)) {
                 // 使用连续READ方案，但仅执行当前时间片可完成的部分
                 if (possibleReadSteps > 0) {
                     for (int i = 0; i < possibleReadSteps; i++) {
-                        HeadTask readTask(ACTION_READ, currentPos);
-                        taskQueues[diskId].push(readTask);
+                        plan.actions.push_back('r');
+                        plan.readPositions.push_back(currentPos);
 
                         diskReadUnits[diskId].erase(currentPos);
                         currentPos = (currentPos % unitCount) + 1;
@@ -324,10 +375,7 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
         int executedPass = std::min(availableTokens, passCount);
         
         // 添加PASS任务
-        for (int i = 0; i < executedPass; i++) {
-            HeadTask passTask(ACTION_PASS);
-            taskQueues[diskId].push(passTask);
-        }
+        plan.actions.append(executedPass, 'p');
         
         // 更新可用令牌和虚拟当前位置
         availableTokens -= executedPass;
@@ -338,6 +386,8 @@ void DiskHeadManager::generateTasksForDisk(int diskId) {
     }
     
     headStates[diskId].currentPosition = currentPos;
+    // 添加结束标记
+    plan.actions.push_back('#');
 }
 
 int DiskHeadManager::findNextReadUnit(int diskId, int currentPos) {
@@ -346,16 +396,8 @@ int DiskHeadManager::findNextReadUnit(int diskId, int currentPos) {
         return -1;
     }
     
-    // 使用 lower_bound 寻找大于等于当前位置的第一个单元
-    auto it = diskReadUnits[diskId].lower_bound(currentPos);
-    
-    // 如果找到大于等于当前位置的单元
-    if (it != diskReadUnits[diskId].end()) {
-        return *it;
-    }
-    
-    // 如果没有找到大于等于当前位置的单元，返回集合中的第一个单元
-    return *diskReadUnits[diskId].begin();
+    // 寻找大于等于当前位置的第一个单元，找不到时从第一个单元开始环形查找
+    return diskReadUnits[diskId].nextSetWrapped(currentPos, 1);
 }
 
 int DiskHeadManager::calculatePassCount(int from, int to) {
@@ -368,16 +410,68 @@ int DiskHeadManager::calculatePassCount(int from, int to) {
     return unitCount - from + to;
 }
 
+double DiskHeadManager::estimateWindowReads(int diskId, int startBucket) const {
+    const PendingReadSet& pending = diskReadUnits[diskId];
+    int bucketCount = pending.getBucketCount();
+    int tokens = maxTokensPerSlice;
+    double reads = 0;
+    for (int i = 0; i < bucketCount && tokens > 0; i++) {
+        int bucket = (startBucket + i) % bucketCount;
+        int pendingCount = pending.getBucketPending(bucket);
+        int units = pending.getBucketUnits(bucket);
+        // 稀疏时逐个 Pass 后单独 Read，密集时连续 Read 穿过整个桶，取较小的消耗
+        int cost = std::min(pendingCount * READ_COST_BY_STATE[0] + (units - pendingCount),
+                            readChainCost(0, units));
+        if (cost <= tokens) {
+            reads += pendingCount;
+            tokens -= cost;
+        } else {
+            reads += static_cast<double>(pendingCount) * tokens / cost;
+            tokens = 0;
+        }
+    }
+    return reads;
+}
+
+int DiskHeadManager::selectJumpTarget(int diskId, int currentPos, int nextUnit) const {
+    if (jumpDensityMargin <= 0) {
+        return nextUnit;
+    }
+    const PendingReadSet& pending = diskReadUnits[diskId];
+    int bestBucket = nextUnit >> PendingReadSet::BUCKET_SHIFT;
+    double bestReads = estimateWindowReads(diskId, bestBucket);
+
+    // 只在下一个待读取单元之后的若干个桶中选择，被越过的单元在下一圈读取，避免长时间饥饿
+    int baseBucket = bestBucket;
+    double baseReads = bestReads;
+    for (int i = 1; i < pending.getBucketCount() && i <= JUMP_LOOKAHEAD_BUCKETS; i++) {
+        int bucket = (baseBucket + i) % pending.getBucketCount();
+        if (pending.getBucketPending(bucket) == 0) {
+            continue;
+        }
+        double reads = estimateWindowReads(diskId, bucket);
+        if (reads > bestReads && reads > baseReads * jumpDensityMargin) {
+            bestReads = reads;
+            bestBucket = bucket;
+        }
+    }
+    if (bestBucket == nextUnit >> PendingReadSet::BUCKET_SHIFT) {
+        return nextUnit;
+    }
+
+    // 跳到该桶内第一个待读取单元
+    int target = pending.nextSet(bestBucket << PendingReadSet::BUCKET_SHIFT);
+    return target == -1 || target == currentPos ? nextUnit : target;
+}
+
 int DiskHeadManager::calculateReadTokenCost(int diskId) {
     const HeadState& state = headStates[diskId];
     
-    // 如果上一次动作不是Read，则消耗64个令牌
+    // 如果上一次动作不是Read，则消耗64个令牌，否则按衰减状态查表
     if (state.lastAction != ACTION_READ) {
-        return 64;
+        return READ_COST_BY_STATE[0];
     }
-    
-    // 根据规则计算令牌消耗
-    return std::max(16, (int)std::ceil(state.lastTokenCost * 0.8));
+    return READ_COST_BY_STATE[readStateAfterCost(state.lastTokenCost)];
 }
 
 int DiskHeadManager::getHeadPosition(int diskId) const {
@@ -396,9 +490,9 @@ void DiskHeadManager::clearTaskQueue(int diskId) {
     }
 #endif
     
-    while (!taskQueues[diskId].empty()) {
-        taskQueues[diskId].pop();
-    }
+    // 空计划输出 "#"
+    headPlans[diskId].actions.assign(1, '#');
+    headPlans[diskId].readPositions.clear();
 }
 
 int DiskHeadManager::getTaskQueueSize(int diskId) const {
@@ -407,7 +501,9 @@ int DiskHeadManager::getTaskQueueSize(int diskId) const {
         return 0;
     }
 #endif
-    return taskQueues[diskId].size();
+    // 跳跃计划只有一个动作，否则每个字符是一个动作（不计结束标记）
+    const std::string& actions = headPlans[diskId].actions;
+    return actions[0] == 'j' ? 1 : static_cast<int>(actions.size()) - 1;
 }
 
 bool DiskHeadManager::hasReadRequests(int diskId) const {
@@ -425,7 +521,7 @@ int DiskHeadManager::getReadRequestCount(int diskId) const {
         return 0;
     }
 #endif
-    return diskReadUnits[diskId].size();
+    return diskReadUnits[diskId].count();
 }
 
 bool DiskHeadManager::needsRead(int diskId, int unitPosition) const {
@@ -435,13 +531,14 @@ bool DiskHeadManager::needsRead(int diskId, int unitPosition) const {
     }
 #endif
     
-    const auto& readUnits = diskReadUnits[diskId];
-    return readUnits.find(unitPosition) != readUnits.end();
+    return diskReadUnits[diskId].contains(unitPosition);
 }
 
 void DiskHeadManager::printTaskQueues() const {
     for (int diskId = 1; diskId <= diskCount; diskId++) {
-        std::cout << getTaskQueueString(diskId) << std::endl;
+        const std::string& actions = headPlans[diskId].actions;
+        outputWriter.append(actions.data(), actions.size());
+        outputWriter.append('\n');
     }
 }
 
@@ -451,79 +548,24 @@ std::string DiskHeadManager::getTaskQueueString(int diskId) const {
         return "";
     }
 #endif
-    
-    std::ostringstream output;
-
-    std::queue<HeadTask> taskQueue = taskQueues[diskId];
-    
-    // 检查队列是否为空
-    if (taskQueue.empty()) {
-        output << "#";
-        return output.str();
-    }
-    
-    // 检查第一个任务是否为JUMP
-    const HeadTask& firstTask = taskQueue.front();
-    if (firstTask.actionType == ACTION_JUMP) {
-        output << "j " << firstTask.targetUnit;
-        taskQueue.pop();
-        return output.str();
-    }
-    
-    // 输出所有非JUMP任务
-    while (!taskQueue.empty()) {
-        const HeadTask& task = taskQueue.front();
-        
-        switch (task.actionType) {
-            case ACTION_PASS:
-                output << "p";
-                break;
-            case ACTION_READ:
-                output << "r";
-                break;
-            default:
-                // 不应该到达这里，因为前面已经处理了JUMP
-                break;
-        }
-        
-        taskQueue.pop();
-    }
-    
-    // 添加结束标记
-    output << "#";
-    
-    return output.str();
+    return headPlans[diskId].actions;
 }
 
-// 执行任务并返回本时间片读取的存储单元
-std::unordered_map<int, std::vector<int>> DiskHeadManager::executeTasks() {
-    std::unordered_map<int, std::vector<int>> readUnitsInThisSlice;
-
+// 执行任务，记录本时间片读取的存储单元
+void DiskHeadManager::executeTasks() {
+    // 读取的单元在规划时已从待读取集合中移除，这里只把计划中的读取单元交换到结果缓冲区，
+    // 两者容量都已预留，不会重新分配
     for (int diskId = 1; diskId <= diskCount; ++diskId) {
-        while (!taskQueues[diskId].empty()) {
-            HeadTask& task = taskQueues[diskId].front();
-
-            if (task.actionType == ACTION_READ) {
-                readUnitsInThisSlice[diskId].push_back(task.targetUnit);
-                // 移除读取请求
-                diskReadUnits[diskId].erase(task.targetUnit);
-            }
-            taskQueues[diskId].pop();
-        }
+        executedReads[diskId].swap(headPlans[diskId].readPositions);
+        clearTaskQueue(diskId);
     }
-    
-    return readUnitsInThisSlice;
 }
 
 int DiskHeadManager::checkSurroundingReadUnits(int diskId, int unitPos, int length, int checkRange) const {
-    int count = 0;
-    for (int i = unitPos - checkRange; i < unitPos + length + checkRange; i++) {
-        int realPos = ((i - 1) % unitCount) + 1;
-        if (needsRead(diskId, realPos)) {
-            count++;
-        }
-    }
-    return count;
+    // 范围起点之前（编号小于1）的部分不回绕，超过V的部分回绕到磁盘开头
+    int start = std::max(unitPos - checkRange, 1);
+    int end = unitPos + length + checkRange - 1;
+    return diskReadUnits[diskId].countCircular(start, end - start + 1);
 }
 
 int DiskHeadManager::getDistanceOfNearestReadUnit(int diskId, int startPos, int length) const {
@@ -532,19 +574,20 @@ int DiskHeadManager::getDistanceOfNearestReadUnit(int diskId, int startPos, int
         return -1;
     }
 
-    // 使用 lower_bound 寻找大于等于当前位置的第一个单元
-    auto it = diskReadUnits[diskId].lower_bound((startPos+length-2) % unitCount + 1);
+    // 寻找大于等于对象末尾位置的第一个单元
+    int next = diskReadUnits[diskId].nextSet((startPos+length-2) % unitCount + 1);
 
     // 如果找到大于等于当前位置的单元
     int behind = INT_MAX;
-    if (it != diskReadUnits[diskId].end()) {
-        behind = *it - (startPos+length-1);
+    if (next != -1) {
+        behind = next - (startPos+length-1);
     }
 
+    // 寻找小于等于对象起始位置的最后一个单元
     int front = INT_MAX;
-    auto it2 = diskReadUnits[diskId].upper_bound((startPos-1) % unitCount + 1);
-    if (it2 != diskReadUnits[diskId].begin()) {
-        front = (startPos - *(--it2));
+    int prev = diskReadUnits[diskId].prevSet((startPos-1) % unitCount + 1);
+    if (prev != -1) {
+        front = (startPos - prev);
     }
 
     return std::min(behind, front) == INT_MAX ? -1 : std::min(behind, front);
@@ -556,17 +599,55 @@ bool DiskHeadManager::isReadDensityHigh(int diskId, int currentPos, int distance
         return false;
     }
     
-    int readCount = 0;
-    int totalUnits = distance;
-    
     // 计算从currentPos开始的distance范围内需要读取的单元数量
-    for (int i = 0; i < distance; i++) {
-        int pos = ((currentPos + i - 1) % unitCount) + 1;
-        if (needsRead(diskId, pos)) {
-            readCount++;
-        }
-    }
+    int readCount = diskReadUnits[diskId].countCircular(currentPos, distance);
     
     // 如果读取密度超过50%，返回true
-    return (static_cast<double>(readCount) / totalUnits) >= 0.49;
+    return (static_cast<double>(readCount) / distance) >= 0.49;
+}
+
+int DiskHeadManager::estimateTokensToRead(int diskId, int unitPos, int extraReads) const {
+    const PendingReadSet& pending = diskReadUnits[diskId];
+    const HeadState& head = headStates[diskId];
+    int headPos = head.currentPosition;
+    int distance = unitPos >= headPos ? unitPos - headPos : unitCount - headPos + unitPos;
+
+    // 磁头与目标之间的读取把路程分成 ahead + 1 个间隔
+    int ahead = std::min(distance, pending.countCircular(headPos, distance) + extraReads);
+    int gaps = ahead + 1;
+    int freeUnits = distance - ahead;
+    if (freeUnits <= gaps * readDensityWindow) {
+        int startState = head.lastAction == ACTION_READ ? readStateAfterCost(head.lastTokenCost) : 0;
+        return readChainCost(startState, distance + 1);
+    }
+    int gapTokens = gaps * std::min(freeUnits / gaps, maxTokensPerSlice);
+    return gapTokens + gaps * READ_COST_BY_STATE[0];
+}
+
+int DiskHeadManager::estimateTokensToReadUnits(int diskId, const int* units, int count) const {
+    if (count <= 0) {
+        return 0;
+    }
+    const PendingReadSet& pending = diskReadUnits[diskId];
+    int headPos = headStates[diskId].currentPosition;
+
+    // 沿磁头移动方向最远的单元最后被读取
+    int target = units[0];
+    int targetDistance = -1;
+    int extraReads = 0;
+    for (int i = 0; i < count; i++) {
+        int distance = units[i] >= headPos ? units[i] - headPos : unitCount - headPos + units[i];
+        if (distance > targetDistance) {
+            target = units[i];
+            targetDistance = distance;
+        }
+        if (!pending.contains(units[i])) {
+            extraReads++;
+        }
+    }
+    // 目标本身不算途中的读取
+    if (!pending.contains(target)) {
+        extraReads--;
+    }
+    return estimateTokensToRead(diskId, target, extraReads);
 }
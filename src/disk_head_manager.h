@@ -2,11 +2,12 @@
 #define DISK_HEAD_MANAGER_H
 
 #include <vector>
-#include <queue>
-#include <unordered_map>
-#include <set>
 #include <string>
 #include "disk_manager.h"
+#include "pending_read_set.h"
+#include "horizon_planner.h"
+#include "read_cost.h"
+#include "worker_pool.h"
 
 // 磁头动作类型
 enum HeadActionType {
@@ -15,13 +16,27 @@ enum HeadActionType {
     ACTION_READ = 2   // 读取当前单元，消耗令牌数根据规则计算
 };
 
-// 磁头任务结构体
-struct HeadTask {
-    HeadActionType actionType;  // 动作类型
-    int targetUnit;             // 目标存储单元（Jump动作需要）
-    
-    HeadTask(HeadActionType type, int target = 0) 
-        : actionType(type), targetUnit(target){}
+// 磁头动作规划器类型
+enum PlannerType {
+    PLANNER_GREEDY = 0,      // 逐段比较连续 Read 与 Pass 的贪心规划
+    PLANNER_HORIZON_DP = 1   // 向后看两个时间片的 (位置, 衰减状态) 动态规划
+};
+
+// 只读的连续存储单元视图，指向内部复用的缓冲区，在下一次 executeTasks 之前有效
+struct UnitSpan {
+    const int* first;
+    const int* last;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return static_cast<int>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// 磁头在一个时间片内的动作计划，缓冲区在各时间片之间复用
+struct HeadPlan {
+    std::string actions;             // 输出的动作字符串：跳跃为 "j x"，否则为 p/r 序列加 "#"
+    std::vector<int> readPositions;  // 按执行顺序读取的存储单元
 };
 
 // 磁头状态结构体
@@ -42,13 +57,33 @@ private:
     int maxTokensPerSlice;      // 每个时间片最大令牌消耗数G
     
     std::vector<HeadState> headStates;                    // 每个磁盘磁头的状态
-    std::vector<std::queue<HeadTask>> taskQueues;         // 每个磁盘磁头的任务队列
+    std::vector<HeadPlan> headPlans;                      // 每个磁盘磁头的动作计划
+    std::vector<std::vector<int>> executedReads;          // 每个磁盘本时间片执行的读取单元，与计划缓冲区交换复用
     
-    // 存储每个磁盘上需要读取的存储单元
-    std::vector<std::set<int>> diskReadUnits;
+    // 存储每个磁盘上需要读取的存储单元及其需求数（需求计数、分层位图加分桶计数，位置即单元编号）
+    std::vector<PendingReadSet> diskReadUnits;
     
     // DiskManager引用
     DiskManager& diskManager;
+
+    // 按磁盘并行生成、执行任务的线程池，为空时串行执行
+    WorkerPool* workerPool;
+
+    // 使用的规划器，以及每个磁盘的DP规划器（各自持有缓冲区，可以并行）
+    PlannerType plannerType;
+    std::vector<HorizonPlanner> horizonPlanners;
+
+    // 跳跃时选择其他窗口所需的预计读取数倍数，不大于0时总是跳到下一个待读取单元
+    double jumpDensityMargin;
+
+    // 选择跳跃目标时向后查看的桶数
+    static constexpr int JUMP_LOOKAHEAD_BUCKETS = 4;
+
+    // 贪心规划中判断前方读取密度的窗口宽度，密度较高时直接连续 Read
+    int readDensityWindow;
+
+    // 软需求的权重：磁头经过只有软需求的单元时，每顺带读取一个按 权重 * 64 个令牌计收益
+    double softDemandWeight;
     
     // 计算Read动作的令牌消耗
     int calculateReadTokenCost(int diskId);
@@ -62,6 +97,12 @@ private:
     // 计算到目标单元需要的Pass次数
     int calculatePassCount(int from, int to);
 
+    // 估计从指定桶开始一个时间片内能读取的待读取单元数
+    double estimateWindowReads(int diskId, int startBucket) const;
+
+    // 选择跳跃目标：在下一个待读取单元之后的各桶窗口中选择一个时间片内预计读取最多的位置，默认为下一个待读取单元
+    int selectJumpTarget(int diskId, int currentPos, int nextUnit) const;
+
     // 检查指定磁盘上指定位置是否存在高读取密度
     bool isReadDensityHigh(int diskId, int currentPos, int distance);
     
@@ -70,21 +111,54 @@ public:
 
     // 获取磁盘数量
     int getDiskCount() const { return diskCount; };
+
+    // 设置按磁盘并行的线程池，传入 nullptr 时串行执行
+    void setWorkerPool(WorkerPool* pool) { workerPool = pool; }
+
+    // 选择磁头动作规划器
+    void setPlannerType(PlannerType type) { plannerType = type; }
+
+    // 设置跳跃目标的密度倍数，不大于0时关闭按密度选择
+    void setJumpDensityMargin(double margin) { jumpDensityMargin = margin; }
+
+    // 默认的读取密度窗口宽度
+    static constexpr int DEFAULT_READ_DENSITY_WINDOW = 6;
+
+    // 设置读取密度窗口宽度
+    void setReadDensityWindow(int window) { readDensityWindow = window; }
+
+    // 设置软需求的权重（0 或 (0, 1]），0表示规划时忽略软需求
+    void setSoftDemandWeight(double weight) { softDemandWeight = weight; }
+
+    // 顺带读取一个软需求单元的收益（令牌数），为0时不必登记软需求
+    int getSoftReadBonus() const { return static_cast<int>(softDemandWeight * READ_COST_BY_STATE[0]); }
     
     // 重置时间片，恢复每个磁盘的令牌数
     void resetTimeSlice();
     
-    // 添加存储单元读取请求
-    bool addReadRequest(int diskId, int unitPosition);
+    // 添加存储单元读取请求，单元的需求数增加 count
+    bool addReadRequest(int diskId, int unitPosition, int count = 1);
     
-    // 批量添加存储单元读取请求
+    // 批量添加存储单元读取请求，每个单元的需求数加一
     bool addReadRequests(int diskId, const std::vector<int>& unitPositions);
     
-    // 取消存储单元读取请求
-    bool cancelReadRequest(int diskId, int unitPosition);
+    // 取消存储单元读取请求，单元的需求数减少 count（最低为0），返回值: 单元是否不再需要读取
+    bool cancelReadRequest(int diskId, int unitPosition, int count = 1);
 
-    // 批量取消存储单元读取请求
+    // 批量取消存储单元读取请求，每个单元的需求数减一
     bool cancelReadRequests(int diskId, const std::vector<int>& unitPositions);
+
+    // 添加软需求：单元是请求所选副本之外的副本，由经过的磁头按较低的权重顺带读取
+    void addSoftReadRequest(int diskId, int unitPosition, int count = 1);
+
+    // 软需求数减少 count（最低为0）
+    void cancelSoftReadRequest(int diskId, int unitPosition, int count = 1);
+
+    // 撤销存储单元的全部需求（包括软需求）
+    void withdrawReadRequest(int diskId, int unitPosition);
+
+    // 获取存储单元的需求数（等待读取它的请求数）
+    int getReadDemand(int diskId, int unitPosition) const { return diskReadUnits[diskId].getDemand(unitPosition); }
     
     // 取消磁盘上所有读取请求
     void cancelAllReadRequests(int diskId);
@@ -116,8 +190,14 @@ public:
     // 获取指定磁盘的任务队列字符串表示
     std::string getTaskQueueString(int diskId) const;
 
-    // 执行任务并返回本时间片读取的存储单元 <diskId, [读取的存储单元]>
-    std::unordered_map<int, std::vector<int>> executeTasks();
+    // 执行任务，本时间片读取的存储单元通过 getExecutedReads 获取
+    void executeTasks();
+
+    // 获取指定磁盘在最近一次 executeTasks 中读取的存储单元
+    UnitSpan getExecutedReads(int diskId) const {
+        const std::vector<int>& reads = executedReads[diskId];
+        return {reads.data(), reads.data() + reads.size()};
+    }
 
     // 获取磁盘单元数
     int getUnitCount() const { return unitCount; }
@@ -126,13 +206,35 @@ public:
     const DiskManager& getDiskManager() const { return diskManager; }
 
     // 获取磁头未读取的单元数
-    int getHeadReadLoad(int diskId) const { return diskReadUnits[diskId].size(); }
+    int getHeadReadLoad(int diskId) const { return diskReadUnits[diskId].count(); }
 
     // 检查指定存储单元周围存在要读取的单元数量
     int checkSurroundingReadUnits(int diskId, int unitPos, int length, int checkRange) const;
 
     // 获取最近的读取单元距离
     int getDistanceOfNearestReadUnit(int diskId, int startPos, int length) const;
+
+    /**
+     * 估计磁头从当前位置开始读到 unitPos 所需的令牌数
+     * 按磁头与目标之间待读取单元（加上 extraReads 个尚未登记的读取）的数量和平均间隔近似：
+     * 间隔不超过读取密度窗口时从磁头当前的衰减状态连续 Read 通过，
+     * 否则逐个间隔 Pass（超过一个时间片的间隔按 Jump 计）并从64开始 Read
+     */
+    int estimateTokensToRead(int diskId, int unitPos, int extraReads = 0) const;
+
+    /**
+     * 估计磁头读完一组单元所需的令牌数：以沿磁头移动方向最远的单元为目标，
+     * 其余尚未待读取的单元作为途中额外的读取
+     */
+    int estimateTokensToReadUnits(int diskId, const int* units, int count) const;
+
+    // 将令牌数换算为完成所在的时间片（当前时间片为1）
+    int tokensToSlices(int tokens) const { return tokens / maxTokensPerSlice + 1; }
+
+    // 估计 unitPos 在第几个时间片被读取（当前时间片为1）
+    int estimateReadSlices(int diskId, int unitPos) const {
+        return tokensToSlices(estimateTokensToRead(diskId, unitPos));
+    }
 };
 
 #endif // DISK_HEAD_MANAGER_H 
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include <cassert>
 #include <cstring>
 #include <algorithm>
-#include <map>
 #include <iostream>
 #include <fstream>
 #include <cmath>
@@ -18,9 +17,13 @@ DiskManager::DiskManager(int diskNum, int unitNum, FrequencyData& freqData)
     // 初始化标签相关的数据结构
     diskTagFreeSpaces.resize(n + 1);
     diskTagRanges.resize(n + 1);
+    unitTags.resize(n + 1);
+    tagDeltaBuffer.resize(frequencyData.getTagCount() + 1, 0);
+    freeRunTrees.resize(n + 1);
     
     for (int i = 1; i <= n; i++) {
         diskUnits[i].resize(v + 1, -1);  // 初始时所有单元都是空闲的(-1)
+        freeRunTrees[i].init(v);
         // 初始化每个磁盘的标签空闲空间数组
         diskTagFreeSpaces[i].resize(frequencyData.getTagCount() + 1, 0);
     }
@@ -63,10 +66,16 @@ void DiskManager::initializePreallocatedSpace() {
         // 存储标签区间信息
         diskTagRanges[diskId] = diskAllocations;
         
-        // 初始化每个标签的空闲空间
+        // 初始化每个标签的空闲空间，并建立单元到标签的映射（区间重叠时排在前面的区间优先）
+        unitTags[diskId].assign(v + 1, -1);
         for (const auto& [startUnit, endUnit, tag] : diskAllocations) {
             int rangeSize = endUnit - startUnit + 1;
             diskTagFreeSpaces[diskId][tag] = rangeSize;
+            for (int i = std::max(startUnit, 1); i <= std::min(endUnit, v); i++) {
+                if (unitTags[diskId][i] == -1) {
+                    unitTags[diskId][i] = tag;
+                }
+            }
         }
     }
 }
@@ -77,6 +86,15 @@ void DiskManager::updateTagFreeSpace(int diskId, int tag, int change) {
     }
 }
 
+void DiskManager::applyTagDelta(int diskId, int sign) {
+    for (int tag = 0; tag < static_cast<int>(tagDeltaBuffer.size()); tag++) {
+        if (tagDeltaBuffer[tag] != 0) {
+            updateTagFreeSpace(diskId, tag, sign * tagDeltaBuffer[tag]);
+            tagDeltaBuffer[tag] = 0;
+        }
+    }
+}
+
 int DiskManager::getTagFreeSpace(int diskId, int tag) const {
     if (diskId >= 1 && diskId <= n && tag >= 0 && tag < static_cast<int>(diskTagFreeSpaces[diskId].size())) {
         return diskTagFreeSpaces[diskId][tag];
@@ -84,30 +102,27 @@ int DiskManager::getTagFreeSpace(int diskId, int tag) const {
     return -1;
 }
 
+void DiskManager::occupyUnits(int diskId, int start, int length, int firstObjectIndex) {
+    for (int i = 0; i < length; i++) {
+        diskUnits[diskId][start + i] = firstObjectIndex + i;
+    }
+    freeRunTrees[diskId].setRange(start, start + length - 1, false);
+}
+
+void DiskManager::releaseUnits(int diskId, int start, int length) {
+    for (int i = start; i < start + length; i++) {
+        diskUnits[diskId][i] = -1;
+    }
+    freeRunTrees[diskId].setRange(start, start + length - 1, true);
+}
+
 std::pair<int, int> DiskManager::findConsecutiveFreeUnits(int diskId, int size) const {
-    // 寻找磁盘上连续的空闲单元
-    int startPos = -1;
-    int consecutiveCount = 0;
-    
-    for (int i = 1; i <= v; i++) {
-        if (diskUnits[diskId][i] == -1) {  // 空闲单元
-            if (startPos == -1) {
-                startPos = i;  // 记录开始位置
-                consecutiveCount = 1;
-            } else {
-                consecutiveCount++;
-            }
-            
-            if (consecutiveCount >= size) {
-                return {startPos, consecutiveCount};  // 找到足够大的连续空间
-            }
-        } else {  // 非空闲单元，重置计数
-            startPos = -1;
-            consecutiveCount = 0;
-        }
+    // 寻找磁盘上第一段足够长的连续空闲单元（first-fit）
+    int startPos = freeRunTrees[diskId].findFirst(size);
+    if (startPos == -1) {
+        return {-1, 0};  // 未找到连续空间
     }
-    
-    return {-1, 0};  // 未找到连续空间
+    return {startPos, size};
 }
 
 // 在指定的区间内寻找连续的空闲单元
@@ -118,28 +133,11 @@ std::pair<int, int> DiskManager::findConsecutiveFreeUnits(int diskId, int size,
     }
 #endif
 
-    int startPos = -1;
-    int consecutiveCount = 0;
-    
-    for (int i = startUnit; i <= endUnit; i++) {
-        if (diskUnits[diskId][i] == -1) {  // 空闲单元
-            if (startPos == -1) {
-                startPos = i;  // 记录开始位置
-                consecutiveCount = 1;
-            } else {
-                consecutiveCount++;
-            }
-            
-            if (consecutiveCount >= size) {
-                return {startPos, consecutiveCount};  // 找到足够大的连续空间
-            }
-        } else {  // 非空闲单元，重置计数
-            startPos = -1;
-            consecutiveCount = 0;
-        }
+    int startPos = freeRunTrees[diskId].findFirst(size, startUnit, endUnit);
+    if (startPos == -1) {
+        return {-1, 0};  // 未找到连续空间
     }
-    
-    return {-1, 0};  // 未找到连续空间
+    return {startPos, size};
 }
 
 std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int size, int tag) {
@@ -169,12 +167,8 @@ std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int siz
         
         if (startPos != -1) {
             // 找到连续空间，分配它
-            int objectIndex = 0;
-            for (int i = startPos; i < startPos + consecutiveSize; i++) {
-                diskUnits[diskId][i] = objectIndex++;  // 设为已分配但未读取
-            }
+            occupyUnits(diskId, startPos, consecutiveSize, 0);  // 设为已分配但未读取
 
-            
             // 创建并返回分配的块
             result.push_back({startPos, consecutiveSize});
             remaining -= consecutiveSize;
@@ -208,9 +202,7 @@ std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int siz
     } else {
         // 分配失败，恢复已分配的单元
         for (const auto& block : result) {
-            for (int i = block.first; i < block.first + block.second; i++) {
-                diskUnits[diskId][i] = -1;  // 恢复为空闲
-            }
+            releaseUnits(diskId, block.first, block.second);  // 恢复为空闲
         }
         // updateTagFreeSpace(diskId, tag, size);
 
@@ -237,24 +229,19 @@ std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int siz
     
     if (startPos != -1) {
         // 找到连续空间，分配它
-        int objectIndex = 0;
-        for (int i = startPos; i < startPos + size; i++) {
-            diskUnits[diskId][i] = objectIndex++;  // 设为已分配但未读取
-        }
+        occupyUnits(diskId, startPos, size, 0);  // 设为已分配但未读取
         
         // 更新磁盘空闲空间信息
         diskFreeSpaces[diskId] -= size;
         
         // 更新受影响的标签的空闲空间
+        const std::vector<int>& tags = unitTags[diskId];
         for (int i = startPos; i < startPos + size; i++) {
-            for (const auto& [startUnit, endUnit, tag] : diskTagRanges[diskId]) {
-                if (i >= startUnit && i <= endUnit) {
-                    // 找到了所属标签，更新该标签的空闲空间
-                    updateTagFreeSpace(diskId, tag, -1);
-                    break;
-                }
+            if (tags[i] != -1) {
+                tagDeltaBuffer[tags[i]]++;
             }
         }
+        applyTagDelta(diskId, -1);
         
         // 创建并返回分配的块
         std::vector<std::pair<int, int>> result;
@@ -267,33 +254,33 @@ std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int siz
         
         // 逐个分配空闲单元
         int objectIndex = 0;
-        std::map<int, int> tagAllocatedUnits; // 记录每个标签分配的单元数量
+        const std::vector<int>& tags = unitTags[diskId];
         
-        for (int i = 1; i <= v && remaining > 0; i++) {
-            if (diskUnits[diskId][i] == -1) {  // 空闲单元
-                int startBlock = i;
-                int blockSize = 0;
-                
-                // 寻找连续的空闲单元
-                while (i <= v && diskUnits[diskId][i] == -1 && blockSize < remaining) {
-                    // 查找该位置属于哪个标签
-                    for (const auto& [startUnit, endUnit, tag] : diskTagRanges[diskId]) {
-                        if (i >= startUnit && i <= endUnit) {
-                            // 找到了所属标签，更新该标签的分配计数
-                            tagAllocatedUnits[tag]++;
-                            break;
-                        }
-                    }
-                    
-                    diskUnits[diskId][i] = objectIndex++;  // 设为已分配
-                    blockSize++;
-                    i++;
+        int searchFrom = 1;
+        while (remaining > 0 && searchFrom <= v) {
+            // 使用线段树直接定位下一个空闲单元
+            int startBlock = freeRunTrees[diskId].findFirst(1, searchFrom, v);
+            if (startBlock == -1) {
+                break;
+            }
+            int blockSize = 0;
+            
+            // 寻找连续的空闲单元
+            int i = startBlock;
+            while (i <= v && diskUnits[diskId][i] == -1 && blockSize < remaining) {
+                // 记录每个标签分配的单元数量
+                if (tags[i] != -1) {
+                    tagDeltaBuffer[tags[i]]++;
                 }
-                
-                result.push_back({startBlock, blockSize});
-                remaining -= blockSize;
-                i--;  // 回退一步，因为循环会自增
+                blockSize++;
+                i++;
             }
+            occupyUnits(diskId, startBlock, blockSize, objectIndex);  // 设为已分配
+            objectIndex += blockSize;
+            
+            result.push_back({startBlock, blockSize});
+            remaining -= blockSize;
+            searchFrom = i;
         }
         
         if (remaining <= 0) {
@@ -301,18 +288,15 @@ std::vector<std::pair<int, int>> DiskManager::allocateOnDisk(int diskId, int siz
             diskFreeSpaces[diskId] -= size;
             
             // 更新各标签的空闲空间
-            for (const auto& [tag, count] : tagAllocatedUnits) {
-                updateTagFreeSpace(diskId, tag, -count);
-            }
+            applyTagDelta(diskId, -1);
             
             return result;  // 成功分配所有需要的空间
         } else {
             // 分配失败，恢复已分配的单元
             std::cerr << "碎片化分配失败" << std::endl;
+            std::fill(tagDeltaBuffer.begin(), tagDeltaBuffer.end(), 0);
             for (const auto& block : result) {
-                for (int i = block.first; i < block.first + block.second; i++) {
-                    diskUnits[diskId][i] = -1;  // 恢复为空闲
-                }
+                releaseUnits(diskId, block.first, block.second);  // 恢复为空闲
             }
             return {};  // 返回空向量表示失败
         }
@@ -327,7 +311,7 @@ bool DiskManager::freeOnDisk(int diskId, const std::vector<std::pair<int, int>>&
 #endif
     
     int freedUnits = 0;
-    std::map<int, int> tagFreedUnits; // 记录每个标签释放的单元数量
+    const std::vector<int>& tags = unitTags[diskId];
     
     // 释放指定的块
     for (const auto& block : blocks) {
@@ -336,6 +320,7 @@ bool DiskManager::freeOnDisk(int diskId, const std::vector<std::pair<int, int>>&
         
 #ifndef NDEBUG
         if (start < 1 || start + length - 1 > v || length <= 0) {
+            std::fill(tagDeltaBuffer.begin(), tagDeltaBuffer.end(), 0);
             return false; // 块范围错误
         }
 #endif
@@ -346,25 +331,20 @@ bool DiskManager::freeOnDisk(int diskId, const std::vector<std::pair<int, int>>&
                 diskUnits[diskId][i] = -1;  // 设为空闲
                 freedUnits++;
                 
-                // 查找该位置属于哪个标签
-                for (const auto& [startUnit, endUnit, tag] : diskTagRanges[diskId]) {
-                    if (i >= startUnit && i <= endUnit) {
-                        // 找到了所属标签，更新该标签的释放计数
-                        tagFreedUnits[tag]++;
-                        break;
-                    }
+                // 记录每个标签释放的单元数量
+                if (tags[i] != -1) {
+                    tagDeltaBuffer[tags[i]]++;
                 }
             }
         }
+        freeRunTrees[diskId].setRange(start, start + length - 1, true);
     }
     
     // 更新磁盘空闲空间信息
     diskFreeSpaces[diskId] += freedUnits;
     
     // 更新各标签的空闲空间
-    for (const auto& [tag, count] : tagFreedUnits) {
-        updateTagFreeSpace(diskId, tag, count);
-    }
+    applyTagDelta(diskId, 1);
     
     return true;
 }
@@ -408,6 +388,7 @@ bool DiskManager::setBlockRead(int diskId, int position, int objectIndex) {
     // 注意：现在我们接受objectIndex为0，因为对象序号可以从0开始
     if (diskUnits[diskId][position] >= -1) {  // -1表示空闲，>=0表示已分配
         diskUnits[diskId][position] = objectIndex;  // 设置为对象中的序号
+        freeRunTrees[diskId].setRange(position, position, objectIndex == -1);
         return true;
     }
     
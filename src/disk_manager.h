@@ -7,6 +7,7 @@
 #include <set>
 #include <map>
 #include <tuple>
+#include "free_run_tree.h"
 // #include <functional>
 
 // 前向声明
@@ -145,6 +146,9 @@ private:
     // -1: 空闲,  >= 0: 在object内的排序
     std::vector<std::vector<int>> diskUnits;
 
+    // 每个磁盘的空闲区间线段树，与 diskUnits 中的空闲状态保持同步
+    std::vector<FreeRunTree> freeRunTrees;
+
     FrequencyData& frequencyData;
     
     // 每个磁盘的空闲块数量
@@ -158,10 +162,23 @@ private:
     // diskTagRanges[diskId] 存储该磁盘上的所有标签区间
     // 每个区间是一个元组 (startUnit, endUnit, tag)
     std::vector<std::vector<std::tuple<int, int, int>>> diskTagRanges;
+
+    // 每个磁盘的单元到标签映射
+    // unitTags[diskId][unit] 为该单元所属的标签区间，-1表示不属于任何标签
+    std::vector<std::vector<int>> unitTags;
+
+    // 单次分配/释放时按标签累计的变化量，长度为标签数+1，使用后清零
+    std::vector<int> tagDeltaBuffer;
     
     // 更新磁盘负载信息
     void updateDiskLoadInfo();
     
+    // 将区间内的单元依次设置为对象内的序号，并更新空闲区间线段树
+    void occupyUnits(int diskId, int start, int length, int firstObjectIndex);
+
+    // 将区间内的单元设置为空闲，并更新空闲区间线段树
+    void releaseUnits(int diskId, int start, int length);
+
     // 查找连续空闲单元
     std::pair<int, int> findConsecutiveFreeUnits(int diskId, int size) const;
     
@@ -173,6 +190,9 @@ private:
     
     // 更新指定标签在指定磁盘上的空闲块数量
     void updateTagFreeSpace(int diskId, int tag, int change);
+
+    // 将 tagDeltaBuffer 中累计的变化量乘以 sign 后应用到磁盘，并清空缓冲区
+    void applyTagDelta(int diskId, int sign);
 };
 
 #endif // DISK_MANAGER_H 
\ No newline at end of file
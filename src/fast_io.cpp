@@ -0,0 +1,271 @@
+#include "fast_io.h"
+#include "trace_file.h"
+#include "profiler.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+InputScanner::InputScanner(int fd)
+    : fd(fd), buffer(new char[BUFFER_SIZE]), cur(nullptr), end(nullptr), reachedEof(false),
+      binaryMode(false), recorder(nullptr) {
+    cur = end = buffer;
+}
+
+InputScanner::~InputScanner() {
+    delete[] buffer;
+}
+
+void InputScanner::setFd(int newFd) {
+    fd = newFd;
+    cur = end = buffer;
+    reachedEof = false;
+    binaryMode = false;
+}
+
+void InputScanner::attachBinary(const uint8_t* begin, const uint8_t* dataEnd) {
+    cur = reinterpret_cast<const char*>(begin);
+    end = reinterpret_cast<const char*>(dataEnd);
+    reachedEof = true;
+    binaryMode = true;
+}
+
+bool InputScanner::refill() {
+    if (reachedEof) {
+        return false;
+    }
+
+    // 只请求一次read，拿到当前可读的数据即返回，不等待缓冲区填满
+    ssize_t bytes;
+    do {
+        bytes = ::read(fd, buffer, BUFFER_SIZE);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes <= 0) {
+        reachedEof = true;
+        cur = end = buffer;
+        return false;
+    }
+
+    cur = buffer;
+    end = buffer + bytes;
+    return true;
+}
+
+bool InputScanner::skipWhitespace() {
+    for (;;) {
+#if defined(__SSE2__)
+        // 每次检查16个字节，找到第一个大于空格的字符
+        // SSE2 只有有符号比较，两边翻转符号位后等价于与标量路径一致的无符号比较
+        const __m128i signBit = _mm_set1_epi8(static_cast<char>(0x80));
+        const __m128i space = _mm_xor_si128(_mm_set1_epi8(' '), signBit);
+        while (cur + 16 <= end) {
+            __m128i chunk = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cur)), signBit);
+            int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, space));
+            if (mask != 0) {
+                cur += __builtin_ctz(mask);
+                return true;
+            }
+            cur += 16;
+        }
+#endif
+        while (cur < end) {
+            if (static_cast<unsigned char>(*cur) > ' ') {
+                return true;
+            }
+            ++cur;
+        }
+
+        if (!refill()) {
+            return false;
+        }
+    }
+}
+
+int InputScanner::readInt() {
+    int value = binaryMode ? decodeVarint() : parseTextInt();
+    if (recorder != nullptr) {
+        recorder->appendInt(value);
+    }
+    return value;
+}
+
+int InputScanner::decodeVarint() {
+    uint32_t encoded = 0;
+    int shift = 0;
+    while (cur < end && shift < 35) {
+        uint8_t byte = static_cast<uint8_t>(*cur++);
+        encoded |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+        shift += 7;
+    }
+    return static_cast<int>((encoded >> 1) ^ (0u - (encoded & 1)));
+}
+
+int InputScanner::parseTextInt() {
+    if (!skipWhitespace()) {
+        return 0;
+    }
+
+    bool negative = false;
+    if (*cur == '-') {
+        negative = true;
+        ++cur;
+    }
+
+    int value = 0;
+    for (;;) {
+        // 数字可能跨越缓冲区边界
+        if (cur == end && !refill()) {
+            break;
+        }
+        unsigned digit = static_cast<unsigned char>(*cur) - '0';
+        if (digit > 9) {
+            break;
+        }
+        value = value * 10 + static_cast<int>(digit);
+        ++cur;
+    }
+
+    return negative ? -value : value;
+}
+
+bool InputScanner::skipToken() {
+    // 二进制录制数据中不保存非整数记号
+    if (binaryMode) {
+        return cur < end;
+    }
+    if (!skipWhitespace()) {
+        return false;
+    }
+
+    for (;;) {
+        while (cur < end && static_cast<unsigned char>(*cur) > ' ') {
+            ++cur;
+        }
+        if (cur < end || !refill()) {
+            return true;
+        }
+    }
+}
+
+bool InputScanner::eof() {
+    if (binaryMode) {
+        return cur >= end;
+    }
+    return !skipWhitespace();
+}
+
+// 两位数字查找表，每次转换两位
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+OutputWriter::OutputWriter(int fd)
+    : fd(fd), buffer(new char[INITIAL_CAPACITY]), size(0), capacity(INITIAL_CAPACITY), bytesWritten(0) {}
+
+OutputWriter::~OutputWriter() {
+    flush();
+    delete[] buffer;
+}
+
+void OutputWriter::setFd(int newFd) {
+    flush();
+    fd = newFd;
+}
+
+void OutputWriter::grow(size_t extra) {
+    size_t newCapacity = capacity;
+    while (newCapacity - size < extra) {
+        newCapacity *= 2;
+    }
+    char* newBuffer = new char[newCapacity];
+    std::memcpy(newBuffer, buffer, size);
+    delete[] buffer;
+    buffer = newBuffer;
+    capacity = newCapacity;
+}
+
+void OutputWriter::append(const char* str, size_t length) {
+    if (capacity - size < length) {
+        grow(length);
+    }
+    std::memcpy(buffer + size, str, length);
+    size += length;
+}
+
+void OutputWriter::append(const char* str) {
+    append(str, std::strlen(str));
+}
+
+void OutputWriter::appendInt(int value) {
+    // int 最多11个字符（含负号）
+    if (capacity - size < 11) {
+        grow(11);
+    }
+
+    unsigned int magnitude = static_cast<unsigned int>(value);
+    if (value < 0) {
+        buffer[size++] = '-';
+        magnitude = 0u - magnitude;
+    }
+
+    // 从后往前填充到临时缓冲区
+    char digits[10];
+    char* p = digits + sizeof(digits);
+    while (magnitude >= 100) {
+        unsigned int pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    }
+    if (magnitude >= 10) {
+        unsigned int pair = magnitude * 2;
+        *--p = DIGIT_PAIRS[pair + 1];
+        *--p = DIGIT_PAIRS[pair];
+    } else {
+        *--p = static_cast<char>('0' + magnitude);
+    }
+
+    size_t length = digits + sizeof(digits) - p;
+    std::memcpy(buffer + size, p, length);
+    size += length;
+}
+
+void OutputWriter::flush() {
+    if (size == 0) {
+        return;
+    }
+
+    PROFILE_SCOPE(PROFILE_OUTPUT);
+    bytesWritten += size;
+    if (fd >= 0) {
+        // 处理部分写入，直到全部写出
+        const char* data = buffer;
+        size_t remaining = size;
+        while (remaining > 0) {
+            ssize_t written = ::write(fd, data, remaining);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+    }
+    size = 0;
+}
@@ -0,0 +1,157 @@
+#ifndef FAST_IO_H
+#define FAST_IO_H
+
+#include <cstddef>
+#include <cstdint>
+
+class TraceRecorder;
+
+/**
+ * 输入扫描器，替代 std::cin 的格式化读取
+ *
+ * 使用大缓冲区配合 read(2) 读取输入，手写整数解析，空白字符跳过使用 SIMD。
+ * 只有当缓冲区耗尽且当前记号还需要更多字节时才会调用 read(2)，
+ * read(2) 返回当前可读的字节即可，因此在交互式判题器下不会等待下一个时间片的数据。
+ *
+ * 也可以直接挂接一段二进制录制数据（见 trace_file.h），此时按变长整数解码，不拷贝数据。
+ */
+class InputScanner {
+public:
+    /**
+     * 构造函数
+     * 参数 fd: 读取的文件描述符，默认为标准输入
+     */
+    explicit InputScanner(int fd = 0);
+
+    ~InputScanner();
+
+    InputScanner(const InputScanner&) = delete;
+    InputScanner& operator=(const InputScanner&) = delete;
+
+    /**
+     * 切换读取的文件描述符，并丢弃缓冲区中未读取的数据
+     * 参数 fd: 新的文件描述符
+     */
+    void setFd(int fd);
+
+    /**
+     * 切换为从内存中的二进制录制数据读取，读取的整数按 zigzag + LEB128 解码
+     * 参数 begin/end: 数据范围 [begin, end)，调用者保证其生命周期
+     */
+    void attachBinary(const uint8_t* begin, const uint8_t* end);
+
+    /**
+     * 设置录制器，之后读取到的每个整数都会追加到录制器中
+     * 参数 recorder: 录制器，为nullptr时停止录制
+     */
+    void setRecorder(TraceRecorder* recorder) { this->recorder = recorder; }
+
+    /**
+     * 读取一个整数（允许前导空白和负号）
+     * 返回值: 读取到的整数，输入结束时返回0
+     */
+    int readInt();
+
+    /**
+     * 跳过一个由非空白字符组成的记号（例如 "TIMESTAMP"）
+     * 返回值: 是否成功跳过
+     */
+    bool skipToken();
+
+    /**
+     * 检查输入是否已经结束（会跳过空白字符）
+     */
+    bool eof();
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+    int fd;              // 文件描述符
+    char* buffer;        // 读取缓冲区
+    const char* cur;     // 当前读取位置
+    const char* end;     // 缓冲区有效数据末尾
+    bool reachedEof;     // 是否已读到输入末尾
+    bool binaryMode;     // 是否在解码二进制录制数据
+    TraceRecorder* recorder; // 录制器
+
+    // 解析一个文本整数
+    int parseTextInt();
+
+    // 解码一个变长整数
+    int decodeVarint();
+
+    // 重新填充缓冲区，返回是否读到了新数据
+    bool refill();
+
+    // 跳过空白字符，返回是否还有非空白字符可读
+    bool skipWhitespace();
+};
+
+/**
+ * 输出缓冲区，替代 std::cout
+ *
+ * 所有协议输出先追加到内存缓冲区，缓冲区按需扩容，
+ * 调用 flush() 时使用一次 write(2) 写出，每个需要判题器响应的阶段只刷新一次。
+ */
+class OutputWriter {
+public:
+    /**
+     * 构造函数
+     * 参数 fd: 写出的文件描述符，默认为标准输出；为-1时丢弃所有输出
+     */
+    explicit OutputWriter(int fd = 1);
+
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    /**
+     * 切换写出的文件描述符（会先刷新已有的输出）
+     * 参数 fd: 新的文件描述符，为-1时丢弃所有输出
+     */
+    void setFd(int fd);
+
+    // 追加单个字符
+    void append(char c) {
+        if (size == capacity) {
+            grow(1);
+        }
+        buffer[size++] = c;
+    }
+
+    // 追加字符串
+    void append(const char* str, size_t length);
+
+    // 追加以'\0'结尾的字符串
+    void append(const char* str);
+
+    // 追加整数的十进制表示
+    void appendInt(int value);
+
+    /**
+     * 将缓冲区内容一次性写出并清空缓冲区
+     */
+    void flush();
+
+    // 获取累计写出（或丢弃）的字节数
+    size_t getBytesWritten() const { return bytesWritten; }
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = 1 << 16;
+
+    int fd;               // 文件描述符
+    char* buffer;         // 输出缓冲区
+    size_t size;          // 缓冲区已使用字节数
+    size_t capacity;      // 缓冲区容量
+    size_t bytesWritten;  // 累计输出字节数
+
+    // 扩容，保证至少还能追加 extra 个字节
+    void grow(size_t extra);
+};
+
+// 全局输入扫描器与输出缓冲区（定义在 main.cpp）
+extern InputScanner inputScanner;
+extern OutputWriter outputWriter;
+
+#endif // FAST_IO_H
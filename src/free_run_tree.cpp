@@ -0,0 +1,100 @@
+#include "free_run_tree.h"
+#include <algorithm>
+
+void FreeRunTree::init(int units) {
+    unitCount = units;
+    leafCount = 1;
+    while (leafCount < units) {
+        leafCount <<= 1;
+    }
+    pre.assign(2 * leafCount, 0);
+    suf.assign(2 * leafCount, 0);
+    best.assign(2 * leafCount, 0);
+
+    // 超出V的叶子视为占用，保证空闲区间不会越过磁盘末尾
+    for (int i = 0; i < units; i++) {
+        int leaf = leafCount + i;
+        pre[leaf] = suf[leaf] = best[leaf] = 1;
+    }
+    for (int node = leafCount - 1; node >= 1; node--) {
+        pull(node);
+    }
+}
+
+void FreeRunTree::pull(int node) {
+    int left = node * 2;
+    int right = left + 1;
+    int half = nodeLength(left);
+    pre[node] = (pre[left] == half) ? half + pre[right] : pre[left];
+    suf[node] = (suf[right] == half) ? half + suf[left] : suf[right];
+    best[node] = std::max({best[left], best[right], suf[left] + pre[right]});
+}
+
+void FreeRunTree::setRange(int start, int end, bool free) {
+    if (start > end) {
+        return;
+    }
+    int value = free ? 1 : 0;
+    int lo = leafCount + start - 1;
+    int hi = leafCount + end - 1;
+    for (int leaf = lo; leaf <= hi; leaf++) {
+        pre[leaf] = suf[leaf] = best[leaf] = value;
+    }
+    // 逐层向上更新受影响的祖先节点
+    for (lo >>= 1, hi >>= 1; lo >= 1; lo >>= 1, hi >>= 1) {
+        for (int node = lo; node <= hi; node++) {
+            pull(node);
+        }
+    }
+}
+
+int FreeRunTree::descend(int node, int nodeStart, int size) const {
+    while (node < leafCount) {
+        int left = node * 2;
+        int right = left + 1;
+        int half = nodeLength(left);
+        if (best[left] >= size) {
+            node = left;
+        } else if (suf[left] + pre[right] >= size) {
+            return nodeStart + half - suf[left];
+        } else {
+            node = right;
+            nodeStart += half;
+        }
+    }
+    return nodeStart;
+}
+
+int FreeRunTree::query(int node, int nodeStart, int nodeEnd, int start, int end, int size, int& run) const {
+    if (nodeEnd < start || nodeStart > end) {
+        return -1;
+    }
+
+    if (start <= nodeStart && nodeEnd <= end) {
+        // 节点完全在查询区间内
+        if (run + pre[node] >= size) {
+            return nodeStart - run;
+        }
+        if (best[node] >= size) {
+            return descend(node, nodeStart, size);
+        }
+        int length = nodeEnd - nodeStart + 1;
+        run = (pre[node] == length) ? run + length : suf[node];
+        return -1;
+    }
+
+    int mid = nodeStart + nodeLength(node) / 2 - 1;
+    int result = query(node * 2, nodeStart, mid, start, end, size, run);
+    if (result != -1) {
+        return result;
+    }
+    return query(node * 2 + 1, mid + 1, nodeEnd, start, end, size, run);
+}
+
+int FreeRunTree::findFirst(int size, int start, int end) const {
+    if (size <= 0 || start < 1 || end > unitCount || start > end || best[1] < size) {
+        return -1;
+    }
+    int run = 0;
+    return query(1, 1, leafCount, start, end, size, run);
+}
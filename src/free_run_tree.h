@@ -0,0 +1,61 @@
+#ifndef FREE_RUN_TREE_H
+#define FREE_RUN_TREE_H
+
+#include <vector>
+
+/**
+ * 空闲区间线段树，用于查找磁盘上的连续空闲单元
+ *
+ * 每个节点记录区间内最长连续空闲长度、从左端开始的空闲前缀长度和到右端结束的空闲后缀长度。
+ * 查询 [start, end] 内第一个长度至少为 size 的连续空闲区间，以及区间置为空闲/占用，均为 O(log V)
+ * （区间修改为 O(length + log V)）。单元编号从1开始。
+ */
+class FreeRunTree {
+public:
+    FreeRunTree() : unitCount(0), leafCount(0) {}
+
+    /**
+     * 初始化，所有单元为空闲
+     * 参数 units: 单元数V
+     */
+    void init(int units);
+
+    /**
+     * 将 [start, end] 内的单元设置为空闲或占用
+     */
+    void setRange(int start, int end, bool free);
+
+    /**
+     * 在 [start, end] 内查找第一个长度至少为 size 的连续空闲区间（first-fit）
+     * 返回值: 区间起始单元，找不到返回-1
+     */
+    int findFirst(int size, int start, int end) const;
+
+    // 在整个磁盘上查找
+    int findFirst(int size) const { return findFirst(size, 1, unitCount); }
+
+    // 整个磁盘上最长的连续空闲长度
+    int getLongestRun() const { return leafCount > 0 ? best[1] : 0; }
+
+private:
+    int unitCount;   // 单元数V
+    int leafCount;   // 叶子数（不小于V的2的幂）
+
+    std::vector<int> pre;   // 空闲前缀长度
+    std::vector<int> suf;   // 空闲后缀长度
+    std::vector<int> best;  // 最长连续空闲长度
+
+    // 节点覆盖的单元数
+    int nodeLength(int node) const { return leafCount >> (31 - __builtin_clz(node)); }
+
+    // 由子节点重新计算节点
+    void pull(int node);
+
+    // 在节点内部查找第一个长度至少为 size 的区间（调用者保证 best[node] >= size）
+    int descend(int node, int nodeStart, int size) const;
+
+    // 递归查询，run 为紧邻当前节点左侧、位于查询区间内的连续空闲长度
+    int query(int node, int nodeStart, int nodeEnd, int start, int end, int size, int& run) const;
+};
+
+#endif // FREE_RUN_TREE_H
@@ -0,0 +1,114 @@
+#include "hierarchical_bitset.h"
+#include <algorithm>
+
+void HierarchicalBitset::init(int maxPosition) {
+    maxPos = maxPosition;
+    setCount = 0;
+    levels.clear();
+    int bits = maxPosition + 1;
+    do {
+        int words = (bits + 63) / 64;
+        levels.emplace_back(words, 0);
+        bits = words;
+    } while (bits > 1);
+}
+
+void HierarchicalBitset::clear() {
+    for (auto& level : levels) {
+        std::fill(level.begin(), level.end(), 0);
+    }
+    setCount = 0;
+}
+
+int HierarchicalBitset::nextSet(int pos) const {
+    if (setCount == 0 || pos > maxPos) {
+        return -1;
+    }
+    if (pos < 0) {
+        pos = 0;
+    }
+
+    // 向上查找第一个包含置位的字
+    size_t level = 0;
+    int index = pos;
+    while (true) {
+        int wordIndex = index >> 6;
+        if (wordIndex >= static_cast<int>(levels[level].size())) {
+            return -1;
+        }
+        uint64_t bits = levels[level][wordIndex] & (~0ULL << (index & 63));
+        if (bits != 0) {
+            index = (wordIndex << 6) + __builtin_ctzll(bits);
+            break;
+        }
+        if (level + 1 == levels.size()) {
+            return -1;
+        }
+        level++;
+        index = wordIndex + 1;
+    }
+
+    // 向下逐层取最低置位
+    while (level > 0) {
+        level--;
+        index = (index << 6) + __builtin_ctzll(levels[level][index]);
+    }
+    return index;
+}
+
+int HierarchicalBitset::prevSet(int pos) const {
+    if (setCount == 0 || pos < 0) {
+        return -1;
+    }
+    if (pos > maxPos) {
+        pos = maxPos;
+    }
+
+    // 向上查找最后一个包含置位的字
+    size_t level = 0;
+    int index = pos;
+    while (true) {
+        int wordIndex = index >> 6;
+        uint64_t bits = levels[level][wordIndex] & (~0ULL >> (63 - (index & 63)));
+        if (bits != 0) {
+            index = (wordIndex << 6) + 63 - __builtin_clzll(bits);
+            break;
+        }
+        if (wordIndex == 0 || level + 1 == levels.size()) {
+            return -1;
+        }
+        level++;
+        index = wordIndex - 1;
+    }
+
+    // 向下逐层取最高置位
+    while (level > 0) {
+        level--;
+        index = (index << 6) + 63 - __builtin_clzll(levels[level][index]);
+    }
+    return index;
+}
+
+int HierarchicalBitset::countRange(int left, int right) const {
+    left = std::max(left, 0);
+    right = std::min(right, maxPos);
+    if (left > right) {
+        return 0;
+    }
+
+    const std::vector<uint64_t>& words = levels[0];
+    int leftWord = left >> 6;
+    int rightWord = right >> 6;
+    uint64_t leftMask = ~0ULL << (left & 63);
+    uint64_t rightMask = ~0ULL >> (63 - (right & 63));
+    if (leftWord == rightWord) {
+        return __builtin_popcountll(words[leftWord] & leftMask & rightMask);
+    }
+
+    int result = __builtin_popcountll(words[leftWord] & leftMask);
+    for (int i = leftWord + 1; i < rightWord; i++) {
+        result += __builtin_popcountll(words[i]);
+    }
+    result += __builtin_popcountll(words[rightWord] & rightMask);
+    return result;
+}
@@ -0,0 +1,121 @@
+#ifndef HIERARCHICAL_BITSET_H
+#define HIERARCHICAL_BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 分层64叉位图，用于记录磁盘上待读取的存储单元
+ *
+ * 第0层每一位对应一个单元，上一层的每一位表示下一层对应的64位字是否非空，
+ * 直到某一层只剩一个字。插入、删除为 O(1)（最多逐层更新 log64(V) 个字），
+ * 查找下一个/上一个置位通过 tzcnt/lzcnt 逐层定位，区间计数为 O(V/64) 次 popcount。
+ * 位置范围为 [0, maxPos]，越界位置视为未置位。
+ */
+class HierarchicalBitset {
+public:
+    HierarchicalBitset() : maxPos(-1), setCount(0) {}
+
+    /**
+     * 初始化为空集合
+     * 参数 maxPosition: 最大位置（单元编号从1开始时传入V）
+     */
+    void init(int maxPosition);
+
+    // 清空所有位置
+    void clear();
+
+    /**
+     * 置位，返回值: 该位置此前是否未置位
+     */
+    bool insert(int pos) {
+        uint64_t bit = 1ULL << (pos & 63);
+        uint64_t& word = levels[0][pos >> 6];
+        if (word & bit) {
+            return false;
+        }
+        bool wasEmpty = word == 0;
+        word |= bit;
+        setCount++;
+        // 字由空变为非空时才需要更新上层
+        for (size_t level = 1; wasEmpty && level < levels.size(); level++) {
+            pos >>= 6;
+            uint64_t& parent = levels[level][pos >> 6];
+            wasEmpty = parent == 0;
+            parent |= 1ULL << (pos & 63);
+        }
+        return true;
+    }
+
+    /**
+     * 清除，返回值: 该位置此前是否已置位
+     */
+    bool erase(int pos) {
+        uint64_t bit = 1ULL << (pos & 63);
+        uint64_t& word = levels[0][pos >> 6];
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+        setCount--;
+        // 字变为空时才需要更新上层
+        bool nowEmpty = word == 0;
+        for (size_t level = 1; nowEmpty && level < levels.size(); level++) {
+            pos >>= 6;
+            uint64_t& parent = levels[level][pos >> 6];
+            parent &= ~(1ULL << (pos & 63));
+            nowEmpty = parent == 0;
+        }
+        return true;
+    }
+
+    // 检查位置是否置位
+    bool contains(int pos) const {
+        if (pos < 0 || pos > maxPos) {
+            return false;
+        }
+        return (levels[0][pos >> 6] >> (pos & 63)) & 1;
+    }
+
+    // 置位数量
+    int count() const { return setCount; }
+
+    // 是否为空
+    bool empty() const { return setCount == 0; }
+
+    /**
+     * 查找大于等于 pos 的第一个置位位置
+     * 返回值: 位置，不存在返回-1
+     */
+    int nextSet(int pos) const;
+
+    /**
+     * 查找小于等于 pos 的最后一个置位位置
+     * 返回值: 位置，不存在返回-1
+     */
+    int prevSet(int pos) const;
+
+    /**
+     * 环形查找：从 pos 开始查找，到达末尾后从 first 开始继续查找
+     * 返回值: 位置，集合为空返回-1
+     */
+    int nextSetWrapped(int pos, int first) const {
+        int result = nextSet(pos);
+        return result != -1 ? result : nextSet(first);
+    }
+
+    /**
+     * 统计 [left, right] 内的置位数量
+     */
+    int countRange(int left, int right) const;
+
+private:
+    int maxPos;     // 最大位置
+    int setCount;   // 置位数量
+
+    // levels[0] 为单元位图，levels[k] 为 levels[k-1] 中各字是否非空的摘要
+    std::vector<std::vector<uint64_t>> levels;
+};
+
+#endif // HIERARCHICAL_BITSET_H
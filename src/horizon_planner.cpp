@@ -0,0 +1,158 @@
+#include "horizon_planner.h"
+#include "read_cost.h"
+#include <algorithm>
+#include <climits>
+
+int HorizonPlanner::plan(PendingReadSet& pending, int unitCount, int startPos, int& lastReadCost,
+                         int tokens, int lookaheadTokens, int softReadBonus,
+                         std::string& actions, std::vector<int>& readPositions) {
+    const int INF = INT_MAX / 2;
+    int pos = startPos;
+
+    while (tokens > 0 && !pending.empty()) {
+        // 规划范围：当前与下一时间片的令牌数，且不超过一圈
+        int budget = tokens + lookaheadTokens;
+        int horizon = std::min(unitCount, budget);
+
+        // 标记范围内的待读取单元
+        requested.assign(horizon, 0);
+        for (int unit = pending.nextSet(pos); unit != -1 && unit - pos < horizon; unit = pending.nextSet(unit + 1)) {
+            requested[unit - pos] = UNIT_REQUESTED;
+        }
+        for (int unit = pending.nextSet(1); unit != -1 && unit < pos && unitCount - pos + unit < horizon;
+             unit = pending.nextSet(unit + 1)) {
+            requested[unitCount - pos + unit] = UNIT_REQUESTED;
+        }
+        if (softReadBonus > 0) {
+            markSoftUnits(pending, unitCount, pos, horizon);
+        }
+
+        // costTable[k * 8 + s]: 处理完前k个位置、下一次 Read 处于状态s的最小令牌消耗
+        int startState = readStateAfterCost(lastReadCost);
+        costTable.assign(static_cast<size_t>(horizon + 1) * DECAY_STATES, INF);
+        tokenTable.resize(static_cast<size_t>(horizon + 1) * DECAY_STATES);
+        parentTable.resize(static_cast<size_t>(horizon + 1) * DECAY_STATES);
+        costTable[startState] = 0;
+        tokenTable[startState] = 0;
+
+        int target = -1;  // 最远的可达待读取单元之后的位置
+        for (int k = 0; k < horizon; k++) {
+            const int* current = &costTable[static_cast<size_t>(k) * DECAY_STATES];
+            const int* currentTokens = &tokenTable[static_cast<size_t>(k) * DECAY_STATES];
+            int* next = &costTable[static_cast<size_t>(k + 1) * DECAY_STATES];
+            int* nextTokens = &tokenTable[static_cast<size_t>(k + 1) * DECAY_STATES];
+            unsigned char* parent = &parentTable[static_cast<size_t>(k + 1) * DECAY_STATES];
+            int readBonus = requested[k] == UNIT_SOFT ? softReadBonus : 0;
+            bool reachable = false;
+            for (int s = 0; s < DECAY_STATES; s++) {
+                int cost = current[s];
+                if (cost >= INF) {
+                    continue;
+                }
+                // Read：进入下一个衰减状态
+                int nextState = readStateAfter(s, 1);
+                int readTokens = currentTokens[s] + READ_COST_BY_STATE[s];
+                int readCost = cost + READ_COST_BY_STATE[s] - readBonus;
+                if (readTokens <= budget && readCost < next[nextState]) {
+                    next[nextState] = readCost;
+                    nextTokens[nextState] = readTokens;
+                    parent[nextState] = static_cast<unsigned char>(s | 0x80);
+                    reachable = true;
+                }
+                // Pass：只能跳过不是必须读取的单元，衰减状态重置
+                if (requested[k] != UNIT_REQUESTED && currentTokens[s] + 1 <= budget && cost + 1 < next[0]) {
+                    next[0] = cost + 1;
+                    nextTokens[0] = currentTokens[s] + 1;
+                    parent[0] = static_cast<unsigned char>(s);
+                    reachable = true;
+                }
+            }
+            if (!reachable) {
+                break;
+            }
+            if (requested[k] == UNIT_REQUESTED) {
+                target = k + 1;
+            }
+        }
+
+        if (target == -1) {
+            // 范围内没有可达的待读取单元，向下一个待读取单元移动
+            int nextUnit = pending.nextSetWrapped(pos, 1);
+            int distance = nextUnit >= pos ? nextUnit - pos : unitCount - pos + nextUnit;
+            int passCount = std::min(tokens, distance);
+            if (passCount <= 0) {
+                break;
+            }
+            actions.append(passCount, 'p');
+            tokens -= passCount;
+            pos = (pos + passCount - 1) % unitCount + 1;
+            lastReadCost = 0;
+            continue;
+        }
+
+        // 选择到达目标的最小消耗状态，消耗相同时选择后续 Read 更便宜的状态
+        const int* targetCost = &costTable[static_cast<size_t>(target) * DECAY_STATES];
+        int bestState = 0;
+        for (int s = 1; s < DECAY_STATES; s++) {
+            if (targetCost[s] <= targetCost[bestState]) {
+                bestState = s;
+            }
+        }
+
+        // 回溯动作序列（逆序）
+        path.clear();
+        for (int k = target, s = bestState; k > 0; k--) {
+            unsigned char p = parentTable[static_cast<size_t>(k) * DECAY_STATES + s];
+            path.push_back(p & 0x80 ? 1 : 0);
+            s = p & 0x7f;
+        }
+
+        // 只执行当前时间片放得下的前缀
+        bool sliceFull = false;
+        int state = startState;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            if (*it) {
+                int cost = READ_COST_BY_STATE[state];
+                if (cost > tokens) {
+                    sliceFull = true;
+                    break;
+                }
+                actions.push_back('r');
+                readPositions.push_back(pos);
+                pending.erase(pos);
+                tokens -= cost;
+                lastReadCost = cost;
+                state = readStateAfter(state, 1);
+            } else {
+                if (tokens < 1) {
+                    sliceFull = true;
+                    break;
+                }
+                actions.push_back('p');
+                tokens -= 1;
+                lastReadCost = 0;
+                state = 0;
+            }
+            pos = pos % unitCount + 1;
+        }
+        if (sliceFull) {
+            break;
+        }
+    }
+
+    return pos;
+}
+
+void HorizonPlanner::markSoftUnits(const PendingReadSet& pending, int unitCount, int pos, int horizon) {
+    for (int unit = pending.nextSoft(pos); unit != -1 && unit - pos < horizon; unit = pending.nextSoft(unit + 1)) {
+        if (!requested[unit - pos]) {
+            requested[unit - pos] = UNIT_SOFT;
+        }
+    }
+    for (int unit = pending.nextSoft(1); unit != -1 && unit < pos && unitCount - pos + unit < horizon;
+         unit = pending.nextSoft(unit + 1)) {
+        if (!requested[unitCount - pos + unit]) {
+            requested[unitCount - pos + unit] = UNIT_SOFT;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef HORIZON_PLANNER_H
+#define HORIZON_PLANNER_H
+
+#include <string>
+#include <vector>
+#include "pending_read_set.h"
+#include "read_cost.h"
+
+/**
+ * 基于动态规划的磁头动作规划器
+ *
+ * 从磁头当前位置向前看，在"当前时间片剩余令牌 + 下一时间片令牌"的范围内，
+ * 对 (位置, Read 衰减状态) 做精确DP：每个待读取单元必须 Read，其余单元可以 Pass 或连续 Read，
+ * 求读到最远一个可达待读取单元的最小令牌消耗路径，然后只执行当前时间片放得下的前缀。
+ * 衰减状态只有 64、52、42、34、28、23、19、16 八种，每个位置只需 8 个状态。
+ * 只有软需求的单元可以 Pass，Read 时从目标值中扣除收益 softReadBonus，令牌预算仍按实际消耗计算。
+ */
+class HorizonPlanner {
+public:
+    HorizonPlanner() {}
+
+    /**
+     * 为一个磁盘规划当前时间片的动作
+     * 参数 pending: 磁盘上待读取的单元，规划中读取的单元会被移除
+     * 参数 unitCount: 磁盘单元数V
+     * 参数 startPos: 磁头当前位置
+     * 参数 lastReadCost: 输入输出，上一个动作为 Read 时为其令牌消耗，否则为0
+     * 参数 tokens: 当前时间片可用令牌数
+     * 参数 lookaheadTokens: 额外向后看的令牌数（通常为下一时间片的令牌数G）
+     * 参数 softReadBonus: 读取一个只有软需求的单元的收益（令牌数），0表示忽略软需求
+     * 参数 actions: 追加 p/r 动作
+     * 参数 readPositions: 追加读取的单元
+     * 返回值: 执行后磁头的位置
+     */
+    int plan(PendingReadSet& pending, int unitCount, int startPos, int& lastReadCost,
+             int tokens, int lookaheadTokens, int softReadBonus,
+             std::string& actions, std::vector<int>& readPositions);
+
+private:
+    // 衰减状态数量
+    static constexpr int DECAY_STATES = READ_DECAY_STATES;
+
+    // 在 requested 中标记 [pos, pos + horizon) 内只有软需求的单元
+    void markSoftUnits(const PendingReadSet& pending, int unitCount, int pos, int horizon);
+
+    // 单元的需求类型
+    static constexpr unsigned char UNIT_REQUESTED = 1;  // 待读取，必须 Read
+    static constexpr unsigned char UNIT_SOFT = 2;       // 只有软需求，可以顺带 Read
+
+    // 各位置、各状态的最小目标值（令牌消耗减去软需求收益）及其实际令牌消耗，
+    // 以及回溯信息（前驱状态，最高位表示该步为 Read）
+    std::vector<int> costTable;
+    std::vector<int> tokenTable;
+    std::vector<unsigned char> parentTable;
+    std::vector<unsigned char> requested;
+    std::vector<unsigned char> path;
+};
+
+#endif // HORIZON_PLANNER_H
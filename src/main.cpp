@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <vector>
@@ -11,6 +12,14 @@
 #include "read_request_manager.h"
 #include "constants.h"
 #include "frequency_data.h"
+#include "fast_io.h"
+#include "replay_stats.h"
+#include "trace_file.h"
+#include "profiler.h"
+#include "worker_pool.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
 #include <fstream>
 #include <cmath>
 #include <iomanip>
@@ -19,11 +28,19 @@
 int T, M, N, V, G; // 总时间片数、标签数、磁盘数、每个磁盘的存储单元数、每个磁头每个时间片最多消耗的令牌数
 FrequencyData freqData; // 频率数据
 int currentTimeSlice = 0;
+InputScanner inputScanner; // 标准输入扫描器
+OutputWriter outputWriter; // 标准输出缓冲区
+static TraceRecorder* traceRecorder = nullptr; // 录制器（--record）
+static BinaryTrace* binaryTrace = nullptr;     // 二进制录制文件（--replay）
 
 // 读取系统参数
 void readSystemParameters() {
     // 读取基本参数
-    std::cin >> T >> M >> N >> V >> G;
+    T = inputScanner.readInt();
+    M = inputScanner.readInt();
+    N = inputScanner.readInt();
+    V = inputScanner.readInt();
+    G = inputScanner.readInt();
     
     // 计算分片数量
     int sliceCount = (T - 1) / FRE_PER_SLICING + 1;
@@ -37,26 +54,26 @@ void readSystemParameters() {
     // 读取删除操作频率
     for (int i = 1; i <= M; i++) {
         for (int j = 1; j <= sliceCount; j++) {
-            std::cin >> freqData.getDeleteFrequency()[i][j];
+            freqData.getDeleteFrequency()[i][j] = inputScanner.readInt();
         }
     }
     
     // 读取写入操作频率
     for (int i = 1; i <= M; i++) {
         for (int j = 1; j <= sliceCount; j++) {
-            std::cin >> freqData.getWriteFrequency()[i][j];
+            freqData.getWriteFrequency()[i][j] = inputScanner.readInt();
         }
     }
     
     // 读取读取操作频率
     for (int i = 1; i <= M; i++) {
         for (int j = 1; j <= sliceCount; j++) {
-            std::cin >> freqData.getReadFrequency()[i][j];
+            freqData.getReadFrequency()[i][j] = inputScanner.readInt();
         }
     }
 
-    std::cout << "OK" << std::endl;
-    std::cout.flush();
+    outputWriter.append("OK\n", 3);
+    outputWriter.flush();
 }
 
 // 全局预处理函数
@@ -143,30 +160,45 @@ void globalPreprocessing() {
 
 void timestamp_action()
 {
-    int timestamp;
-    std::string dummy;
-    std::cin >> dummy >> timestamp;
+    // 录制时每个时间片单独成块；回放二进制录制文件时通过索引直接定位到下一个时间片
+    if (traceRecorder != nullptr) {
+        traceRecorder->beginSlice();
+    }
+    if (binaryTrace != nullptr) {
+        const uint8_t* begin = nullptr;
+        const uint8_t* end = nullptr;
+        if (binaryTrace->getSliceBlock(currentTimeSlice + 1, begin, end)) {
+            inputScanner.attachBinary(begin, end);
+        }
+    }
+
+    inputScanner.skipToken(); // "TIMESTAMP"
+    int timestamp = inputScanner.readInt();
     currentTimeSlice = timestamp;
-    std::cout << "TIMESTAMP " << timestamp << std::endl;
-    std::cout.flush();
+    outputWriter.append("TIMESTAMP ", 10);
+    outputWriter.appendInt(timestamp);
+    outputWriter.append('\n');
+    outputWriter.flush();
 }
 
 
 // 处理删除事件
 void handle_delete_events(ReadRequestManager& requestManager) {
-    int n_delete;
-    std::cin >> n_delete;
+    int n_delete = inputScanner.readInt();
     
     // 收集所有被取消的请求ID
     std::vector<int> abortedRequests;
     
     // 处理每个要删除的对象
     for (int i = 0; i < n_delete; i++) {
-        int obj_id;
-        std::cin >> obj_id;
+        int obj_id = inputScanner.readInt();
         
         // 调用ReadRequestManager取消与对象相关的所有请求
-        std::vector<int> cancelledReqs = requestManager.cancelRequestsByObjectId(obj_id);
+        std::vector<int> cancelledReqs;
+        {
+            PROFILE_SCOPE(PROFILE_DELETE);
+            cancelledReqs = requestManager.cancelRequestsByObjectId(obj_id);
+        }
         // 打印取消的请求ID到文件
         #ifndef NDEBUG
         std::ofstream logFile("cancelledReqs.txt", std::ios::app);
@@ -183,35 +215,41 @@ void handle_delete_events(ReadRequestManager& requestManager) {
     }
     
     // 输出被取消的请求数量
-    std::cout << abortedRequests.size() << std::endl;
+    outputWriter.appendInt(static_cast<int>(abortedRequests.size()));
+    outputWriter.append('\n');
     
     // 输出每个被取消的请求ID
     for (int req_id : abortedRequests) {
-        std::cout << req_id << std::endl;
+        outputWriter.appendInt(req_id);
+        outputWriter.append('\n');
     }
     
     // 刷新输出缓冲区
-    std::cout.flush();
+    outputWriter.flush();
 }
 
 // 处理写入事件
 void handle_write_events(ObjectManager& objectManager) {
-    int n_write;
-    std::cin >> n_write;
+    int n_write = inputScanner.readInt();
     
     // 如果当前时间片没有写入事件，直接返回
     if (n_write == 0) {
-        std::cout.flush();
+        outputWriter.flush();
         return;
     }
     
     // 处理每个写入事件
     for (int i = 0; i < n_write; i++) {
-        int obj_id, obj_size, obj_tag;
-        std::cin >> obj_id >> obj_size >> obj_tag;
+        int obj_id = inputScanner.readInt();
+        int obj_size = inputScanner.readInt();
+        int obj_tag = inputScanner.readInt();
         
         // 使用 ObjectManager 创建对象
-        bool success = objectManager.createObject(obj_id, obj_size, obj_tag);
+        bool success;
+        {
+            PROFILE_SCOPE(PROFILE_CREATE_OBJECT);
+            success = objectManager.createObject(obj_id, obj_size, obj_tag);
+        }
         
         if (success) {
             // 获取创建的对象
@@ -219,14 +257,15 @@ void handle_write_events(ObjectManager& objectManager) {
             
             if (obj) {
                 // 输出对象ID
-                std::cout << obj_id << std::endl;
+                outputWriter.appendInt(obj_id);
+                outputWriter.append('\n');
                 
                 // 输出三个副本的存储位置信息
                 for (int rep = 0; rep < REP_NUM; rep++) {
                     const StorageUnit& replica = obj->getReplica(rep);
                     
                     // 输出副本所在的磁盘ID
-                    std::cout << replica.diskId;
+                    outputWriter.appendInt(replica.diskId);
                     
                     // 计算总存储单元数
                     int totalUnits = 0;
@@ -242,32 +281,32 @@ void handle_write_events(ObjectManager& objectManager) {
                         
                         // 输出此块中的每个单元
                         for (int j = 0; j < length; j++) {
-                            std::cout << " " << start + j;
+                            outputWriter.append(' ');
+                            outputWriter.appendInt(start + j);
                             currentUnit++;
                         }
                     }
                     
-                    std::cout << std::endl;
+                    outputWriter.append('\n');
                 }
             }
         }
     }
     
     // 刷新输出缓冲区
-    std::cout.flush();
+    outputWriter.flush();
 }
 
 // 处理读取事件
 void handle_read_events(ReadRequestManager& requestManager) {
-    int n_read;
-    std::cin >> n_read;
+    int n_read = inputScanner.readInt();
     
     
     
     // 处理每个读取事件
     for (int i = 0; i < n_read; i++) {
-        int req_id, obj_id;
-        std::cin >> req_id >> obj_id;
+        int req_id = inputScanner.readInt();
+        int obj_id = inputScanner.readInt();
         
         // 添加读取请求
         requestManager.addReadRequest(req_id, obj_id);
@@ -276,10 +315,134 @@ void handle_read_events(ReadRequestManager& requestManager) {
     // 执行当前时间片的所有请求
     requestManager.executeTimeSlice();
     
-    std::cout.flush();
+    outputWriter.flush();
+}
+
+// 默认的软需求权重（延迟绑定），0表示关闭
+// 在过载、负载不均的磁盘上顺带读取软需求反而降低得分，默认关闭
+constexpr double DEFAULT_LATE_BINDING_WEIGHT = 0;
+
+// 打印命令行用法
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " [--replay <trace>] [--output <file>] [--record <file>] [--threads <n>] [--planner greedy|dp] [--jump-margin <x>] [--density-window <n>] [--admission-limit <n>] [--replica-select balanced|earliest] [--late-binding <w>]\n"
+              << "  不带参数时通过标准输入输出与判题器交互\n"
+              << "  --replay <trace>  从录制文件（文本输入或二进制录制）回放，输出丢弃并在标准错误输出各阶段耗时\n"
+              << "  --output <file>   回放时将输出写入文件而不是丢弃\n"
+              << "  --record <file>   将读取到的输入同时录制为二进制录制文件\n"
+              << "  --threads <n>     按磁盘并行生成任务的线程数（包括主线程），默认1即串行\n"
+              << "  --planner <name>  磁头动作规划器：greedy（默认）或 dp（两个时间片范围内的动态规划）\n"
+              << "  --jump-margin <x> 跳跃时若前方几个桶内的窗口预计读取数超过下一个待读取单元处的x倍则跳到该窗口，默认0即关闭\n"
+              << "  --density-window <n> 贪心规划判断前方读取密度的窗口宽度，默认6\n"
+              << "  --admission-limit <n> 预计n个时间片内读不完且需要新增读取任务的请求直接放弃，0表示全部接受，默认" << ReadRequestManager::DEFAULT_ADMISSION_LIMIT << "\n"
+              << "  --replica-select <name> 副本选择：balanced（默认，负载均衡加就近集中）或 earliest（预计最早读完）\n"
+              << "  --late-binding <w> 在其他副本上登记软需求，磁头顺带读取一个软需求单元按 w * 64 个令牌计收益，w 取 (0, 1]，0表示关闭，默认" << DEFAULT_LATE_BINDING_WEIGHT << "\n";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // 解析命令行参数
+    const char* replayPath = nullptr;
+    const char* outputPath = nullptr;
+    const char* recordPath = nullptr;
+    int threadCount = 1;
+    PlannerType plannerType = PLANNER_GREEDY;
+    double jumpDensityMargin = 0;
+    int readDensityWindow = DiskHeadManager::DEFAULT_READ_DENSITY_WINDOW;
+    int admissionLimit = ReadRequestManager::DEFAULT_ADMISSION_LIMIT;
+    ReplicaSelectPolicy replicaSelectPolicy = REPLICA_SELECT_BALANCED;
+    double lateBindingWeight = DEFAULT_LATE_BINDING_WEIGHT;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--jump-margin") == 0 && i + 1 < argc) {
+            jumpDensityMargin = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--density-window") == 0 && i + 1 < argc) {
+            readDensityWindow = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--admission-limit") == 0 && i + 1 < argc) {
+            admissionLimit = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--late-binding") == 0 && i + 1 < argc) {
+            lateBindingWeight = std::atof(argv[++i]);
+            if (lateBindingWeight < 0 || lateBindingWeight > 1) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--replica-select") == 0 && i + 1 < argc) {
+            const char* policy = argv[++i];
+            if (std::strcmp(policy, "balanced") == 0) {
+                replicaSelectPolicy = REPLICA_SELECT_BALANCED;
+            } else if (std::strcmp(policy, "earliest") == 0) {
+                replicaSelectPolicy = REPLICA_SELECT_EARLIEST;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--planner") == 0 && i + 1 < argc) {
+            const char* planner = argv[++i];
+            if (std::strcmp(planner, "greedy") == 0) {
+                plannerType = PLANNER_GREEDY;
+            } else if (std::strcmp(planner, "dp") == 0) {
+                plannerType = PLANNER_HORIZON_DP;
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // 回放模式：从文件读取输入，输出写入接收端
+    bool replayMode = replayPath != nullptr;
+    BinaryTrace replayTrace;
+    if (replayMode) {
+        if (BinaryTrace::isBinaryTrace(replayPath)) {
+            // 二进制录制文件直接映射到内存解码
+            if (!replayTrace.open(replayPath)) {
+                std::cerr << "无效的二进制录制文件: " << replayPath << std::endl;
+                return 1;
+            }
+            binaryTrace = &replayTrace;
+            inputScanner.attachBinary(replayTrace.getHeaderBegin(), replayTrace.getHeaderEnd());
+        } else {
+            int traceFd = open(replayPath, O_RDONLY);
+            if (traceFd < 0) {
+                std::cerr << "无法打开回放文件: " << replayPath << std::endl;
+                return 1;
+            }
+            inputScanner.setFd(traceFd);
+        }
+
+        int outputFd = -1;
+        if (outputPath != nullptr) {
+            outputFd = open(outputPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (outputFd < 0) {
+                std::cerr << "无法打开输出文件: " << outputPath << std::endl;
+                return 1;
+            }
+        }
+        outputWriter.setFd(outputFd);
+    }
+
+    // 录制模式：读取的输入同时写入二进制录制文件
+    TraceRecorder recorder;
+    if (recordPath != nullptr) {
+        if (!recorder.open(recordPath)) {
+            std::cerr << "无法创建录制文件: " << recordPath << std::endl;
+            return 1;
+        }
+        traceRecorder = &recorder;
+        inputScanner.setRecorder(traceRecorder);
+    }
+
+    ReplayStats replayStats;
+    replayStats.begin();
+
     // 全局预处理
     globalPreprocessing();
     // 创建磁盘管理器
@@ -290,17 +453,52 @@ int main() {
     
     // 创建磁盘磁头管理器
     DiskHeadManager diskHeadManager(N, V, G, diskManager);
+    diskHeadManager.setPlannerType(plannerType);
+    diskHeadManager.setJumpDensityMargin(jumpDensityMargin);
+    diskHeadManager.setReadDensityWindow(readDensityWindow);
+    diskHeadManager.setSoftDemandWeight(lateBindingWeight);
+    WorkerPool workerPool(std::min(threadCount, N));
+    if (workerPool.getThreadCount() > 1) {
+        diskHeadManager.setWorkerPool(&workerPool);
+    }
     
     // 创建读取请求管理器
     ReadRequestManager readRequestManager(objectManager, diskHeadManager);
+    readRequestManager.setAdmissionLimit(admissionLimit);
+    readRequestManager.setReplicaSelectPolicy(replicaSelectPolicy);
+    readRequestManager.setLateBinding(diskHeadManager.getSoftReadBonus() > 0);
     
     // 模拟时间片
+    if (replayMode) {
+        replayStats.end(PHASE_PREPROCESS);
+        for (int t = 1; t <= T + EXTRA_TIME; t++) {
+            timestamp_action();
+            replayStats.end(PHASE_TIMESTAMP);
+            handle_delete_events(readRequestManager);
+            replayStats.end(PHASE_DELETE);
+            handle_write_events(objectManager);
+            replayStats.end(PHASE_WRITE);
+            handle_read_events(readRequestManager);
+            replayStats.end(PHASE_READ);
+            replayStats.addSlice();
+            PROFILE_END_SLICE();
+        }
+        outputWriter.flush();
+        recorder.close();
+        replayStats.report(std::cerr, outputWriter.getBytesWritten());
+        std::cerr << "requests: rejected " << readRequestManager.getRejectedRequestCount()
+                  << ", expired " << readRequestManager.getExpiredRequestCount() << "\n";
+        return 0;
+    }
+
     for (int t = 1; t <= T + EXTRA_TIME; t++) {
         timestamp_action();
         handle_delete_events(readRequestManager);
         handle_write_events(objectManager);
         handle_read_events(readRequestManager);
+        PROFILE_END_SLICE();
     }    
     
+    recorder.close();
     return 0;
-} 
\ No newline at end of file
+}
\ No newline at end of file
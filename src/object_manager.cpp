@@ -27,6 +27,17 @@ const StorageUnit& Object::getReplica(int replicaIndex) const {
     return replicas[replicaIndex];
 }
 
+// 获取对象的第 blockIndex 块在指定副本中的单元位置
+int Object::getUnitPosition(int replicaIndex, int blockIndex) const {
+    for (const auto& blockPair : getReplica(replicaIndex).blockLists) {
+        if (blockIndex < blockPair.second) {
+            return blockPair.first + blockIndex;
+        }
+        blockIndex -= blockPair.second;
+    }
+    return -1;
+}
+
 // 设置指定索引的副本信息
 void Object::setReplica(int replicaIndex, int diskId, const std::vector<std::pair<int, int>>& blockLists) {
 #ifndef NDEBUG
@@ -44,6 +44,8 @@ public:
 
     // 副本管理
     const StorageUnit& getReplica(int replicaIndex) const;
+    // 获取对象第 blockIndex 块（从0开始）在指定副本中的单元位置
+    int getUnitPosition(int replicaIndex, int blockIndex) const;
     // 
     void setReplica(int replicaIndex, int diskId, const std::vector<std::pair<int, int>>& blocks);
 };
@@ -0,0 +1,90 @@
+#ifndef OBJECT_READ_PROGRESS_H
+#define OBJECT_READ_PROGRESS_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "request_table.h"
+
+/**
+ * 单个对象的读取进度
+ *
+ * 对象上的每个请求到达时领取一个递增的序号（ticket），等待队列按序号先进先出。
+ * 每块记录最近一次被读取时的"下一个序号"，序号小于它的请求都在到达后读到了该块；
+ * 所有块中的最小值之前的请求即全部完成。读取一个单元只更新一块的记录，
+ * 再从队首弹出已完成的请求，代价为 O(块数 + 新完成的请求数)，与等待的请求数无关。
+ * 读取任意副本的块都计入进度，与判题规则一致。
+ */
+class ObjectReadProgress {
+public:
+    ObjectReadProgress() : blockCount(0), nextTicket(0), waiterHead(0) {}
+
+    explicit ObjectReadProgress(int blocks)
+        : blockCount(blocks), nextTicket(0), waiterHead(0) {
+        std::fill(blockReadTicket, blockReadTicket + MAX_REQUEST_BLOCKS, 0);
+    }
+
+    /**
+     * 新请求加入等待队列
+     * 返回值: 请求的序号
+     */
+    int addWaiter(int requestId) {
+        int ticket = nextTicket++;
+        waiters.emplace_back(ticket, requestId);
+        return ticket;
+    }
+
+    // 是否还有等待中的请求
+    bool hasWaiters() const { return waiterHead < static_cast<int>(waiters.size()); }
+
+    // 序号为 ticket 的请求到达后第 block 块是否已被读取
+    bool isBlockRead(int block, int ticket) const { return blockReadTicket[block] > ticket; }
+
+    // 序号为 ticket 的请求尚未读取的块（位掩码）
+    unsigned int getUnreadBlocks(int ticket) const {
+        unsigned int mask = 0;
+        for (int block = 0; block < blockCount; block++) {
+            if (!isBlockRead(block, ticket)) {
+                mask |= 1u << block;
+            }
+        }
+        return mask;
+    }
+
+    /**
+     * 第 block 块被读取，对新完成的请求调用 onComplete(requestId)
+     */
+    template <typename Func>
+    void markBlockRead(int block, Func onComplete) {
+        blockReadTicket[block] = nextTicket;
+        int minTicket = *std::min_element(blockReadTicket, blockReadTicket + blockCount);
+        while (waiterHead < static_cast<int>(waiters.size()) && waiters[waiterHead].first < minTicket) {
+            onComplete(waiters[waiterHead].second);
+            waiterHead++;
+        }
+        // 已弹出的部分超过一半时压缩队列
+        if (waiterHead * 2 > static_cast<int>(waiters.size())) {
+            waiters.erase(waiters.begin(), waiters.begin() + waiterHead);
+            waiterHead = 0;
+        }
+    }
+
+    // 遍历等待队列中的请求ID
+    template <typename Func>
+    void forEachWaiter(Func func) const {
+        for (int i = waiterHead; i < static_cast<int>(waiters.size()); i++) {
+            func(waiters[i].second);
+        }
+    }
+
+    int getBlockCount() const { return blockCount; }
+
+private:
+    int blockCount;                                   // 对象块数
+    int nextTicket;                                   // 下一个请求的序号
+    int blockReadTicket[MAX_REQUEST_BLOCKS];          // 每块最近一次被读取时的 nextTicket
+    std::vector<std::pair<int, int>> waiters;         // 等待队列 (序号, 请求ID)，按序号递增
+    int waiterHead;                                   // 队首位置
+};
+
+#endif // OBJECT_READ_PROGRESS_H
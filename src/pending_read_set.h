@@ -0,0 +1,243 @@
+#ifndef PENDING_READ_SET_H
+#define PENDING_READ_SET_H
+
+#include <algorithm>
+#include <vector>
+#include "hierarchical_bitset.h"
+
+/**
+ * 磁盘上待读取单元的集合
+ *
+ * 每个单元记录需求数（有多少个请求在等待读取它），需求数大于0的单元即为待读取单元，
+ * 保存在分层位图中。位图之上按 BUCKET_SIZE 个单元分桶维护待读取数量，增删时增量更新，
+ * 用于按窗口估计各区域的读取密度（例如选择 Jump 目标）。桶计数同时维护一棵树状数组，
+ * 任意区间（包括环形区间）的待读取数量由两端桶内的 popcount 加中间整桶的前缀和得到，
+ * 为 O(log V)，与区间宽度无关。单元编号从1开始。
+ *
+ * 另外记录软需求：请求在选定副本之外的其他副本上登记的需求。只有软需求的单元不算待读取，
+ * 不影响跳跃、密度和负载估计，只在磁头经过时由规划器按较低的权重考虑是否顺带读取。
+ */
+class PendingReadSet {
+public:
+    // 每个桶覆盖的单元数
+    static constexpr int BUCKET_SHIFT = 6;
+    static constexpr int BUCKET_SIZE = 1 << BUCKET_SHIFT;
+
+    PendingReadSet() : unitCount(0) {}
+
+    /**
+     * 初始化为空集合
+     * 参数 units: 磁盘单元数V
+     */
+    void init(int units) {
+        unitCount = units;
+        pendingUnits.init(units);
+        demandCounts.assign(units + 1, 0);
+        softUnits.init(units);
+        softDemandCounts.assign(units + 1, 0);
+        bucketCounts.assign(units / BUCKET_SIZE + 1, 0);
+        bucketTree.assign(bucketCounts.size() + 1, 0);
+    }
+
+    // 清空所有单元
+    void clear() {
+        pendingUnits.clear();
+        std::fill(demandCounts.begin(), demandCounts.end(), 0);
+        softUnits.clear();
+        std::fill(softDemandCounts.begin(), softDemandCounts.end(), 0);
+        std::fill(bucketCounts.begin(), bucketCounts.end(), 0);
+        std::fill(bucketTree.begin(), bucketTree.end(), 0);
+    }
+
+    /**
+     * 单元的需求数增加 count
+     * 返回值: 该单元是否由此变为待读取
+     */
+    bool addDemand(int pos, int count = 1) {
+        if (count <= 0) {
+            return false;
+        }
+        demandCounts[pos] += count;
+        if (demandCounts[pos] != count) {
+            return false;
+        }
+        setPending(pos);
+        return true;
+    }
+
+    /**
+     * 单元的需求数减少 count，最低为0
+     * 返回值: 该单元是否由此不再待读取
+     */
+    bool releaseDemand(int pos, int count = 1) {
+        if (count <= 0 || demandCounts[pos] == 0) {
+            return false;
+        }
+        demandCounts[pos] = std::max(0, demandCounts[pos] - count);
+        if (demandCounts[pos] != 0) {
+            return false;
+        }
+        clearPending(pos);
+        return true;
+    }
+
+    // 单元的软需求数增加 count
+    void addSoftDemand(int pos, int count = 1) {
+        if (count <= 0) {
+            return;
+        }
+        softDemandCounts[pos] += count;
+        softUnits.insert(pos);
+    }
+
+    // 单元的软需求数减少 count，最低为0
+    void releaseSoftDemand(int pos, int count = 1) {
+        if (count <= 0 || softDemandCounts[pos] == 0) {
+            return;
+        }
+        softDemandCounts[pos] = std::max(0, softDemandCounts[pos] - count);
+        if (softDemandCounts[pos] == 0) {
+            softUnits.erase(pos);
+        }
+    }
+
+    /**
+     * 单元已被读取，清除其全部需求（包括软需求）
+     * 返回值: 此前是否待读取
+     */
+    bool erase(int pos) {
+        if (softDemandCounts[pos] != 0) {
+            softDemandCounts[pos] = 0;
+            softUnits.erase(pos);
+        }
+        if (demandCounts[pos] == 0) {
+            return false;
+        }
+        demandCounts[pos] = 0;
+        clearPending(pos);
+        return true;
+    }
+
+    // 单元的需求数
+    int getDemand(int pos) const { return demandCounts[pos]; }
+
+    // 单元的软需求数
+    int getSoftDemand(int pos) const { return softDemandCounts[pos]; }
+
+    // 有软需求的单元
+    bool containsSoft(int pos) const { return softUnits.contains(pos); }
+    int nextSoft(int pos) const { return softUnits.nextSet(pos); }
+
+    /**
+     * 统计从 start 开始连续 length 个单元（越过V后回到1）内有软需求的单元数
+     */
+    int countSoftCircular(int start, int length) const {
+        if (length <= 0) {
+            return 0;
+        }
+        if (length >= unitCount) {
+            return softUnits.count();
+        }
+        int end = start + length - 1;
+        if (end <= unitCount) {
+            return softUnits.countRange(start, end);
+        }
+        return softUnits.countRange(start, unitCount) + softUnits.countRange(1, end - unitCount);
+    }
+
+    bool contains(int pos) const { return pendingUnits.contains(pos); }
+    int count() const { return pendingUnits.count(); }
+    bool empty() const { return pendingUnits.empty(); }
+    int nextSet(int pos) const { return pendingUnits.nextSet(pos); }
+    int prevSet(int pos) const { return pendingUnits.prevSet(pos); }
+    int nextSetWrapped(int pos, int first) const { return pendingUnits.nextSetWrapped(pos, first); }
+
+    /**
+     * 统计 [left, right] 内的待读取单元数，O(log V)
+     */
+    int countRange(int left, int right) const {
+        left = std::max(left, 1);
+        right = std::min(right, unitCount);
+        if (left > right) {
+            return 0;
+        }
+        int leftBucket = left >> BUCKET_SHIFT;
+        int rightBucket = right >> BUCKET_SHIFT;
+        if (rightBucket - leftBucket <= 1) {
+            return pendingUnits.countRange(left, right);
+        }
+        // 两端不完整的桶直接 popcount，中间的整桶用树状数组求和
+        return pendingUnits.countRange(left, ((leftBucket + 1) << BUCKET_SHIFT) - 1) +
+               bucketPrefix(rightBucket) - bucketPrefix(leftBucket + 1) +
+               pendingUnits.countRange(rightBucket << BUCKET_SHIFT, right);
+    }
+
+    /**
+     * 统计从 start 开始连续 length 个单元（越过V后回到1）内的待读取单元数
+     */
+    int countCircular(int start, int length) const {
+        if (length <= 0) {
+            return 0;
+        }
+        if (length >= unitCount) {
+            return count();
+        }
+        int end = start + length - 1;
+        if (end <= unitCount) {
+            return countRange(start, end);
+        }
+        return countRange(start, unitCount) + countRange(1, end - unitCount);
+    }
+
+    // 桶数量，第 b 个桶覆盖单元 [b * BUCKET_SIZE, (b + 1) * BUCKET_SIZE)
+    int getBucketCount() const { return static_cast<int>(bucketCounts.size()); }
+
+    // 第 b 个桶内的待读取单元数
+    int getBucketPending(int bucket) const { return bucketCounts[bucket]; }
+
+    // 第 b 个桶内实际存在的单元数（首尾桶不满）
+    int getBucketUnits(int bucket) const {
+        int first = bucket == 0 ? 1 : bucket * BUCKET_SIZE;
+        int last = std::min(unitCount, (bucket + 1) * BUCKET_SIZE - 1);
+        return last >= first ? last - first + 1 : 0;
+    }
+
+private:
+    int unitCount;                      // 磁盘单元数V
+    std::vector<int> demandCounts;      // 每个单元的需求数
+    HierarchicalBitset pendingUnits;    // 待读取单元（需求数大于0）
+    std::vector<int> softDemandCounts;  // 每个单元的软需求数
+    HierarchicalBitset softUnits;       // 有软需求的单元
+    std::vector<int> bucketCounts;      // 每个桶内的待读取单元数
+    std::vector<int> bucketTree;        // 桶计数的树状数组（下标从1开始，第 b 个桶对应 b + 1）
+
+    void setPending(int pos) {
+        pendingUnits.insert(pos);
+        bucketCounts[pos >> BUCKET_SHIFT]++;
+        updateBucketTree(pos >> BUCKET_SHIFT, 1);
+    }
+
+    void clearPending(int pos) {
+        pendingUnits.erase(pos);
+        bucketCounts[pos >> BUCKET_SHIFT]--;
+        updateBucketTree(pos >> BUCKET_SHIFT, -1);
+    }
+
+    // 第 bucket 个桶的计数增加 delta
+    void updateBucketTree(int bucket, int delta) {
+        for (int i = bucket + 1; i < static_cast<int>(bucketTree.size()); i += i & -i) {
+            bucketTree[i] += delta;
+        }
+    }
+
+    // 前 bucket 个桶（第 0 到 bucket - 1 个）的计数之和
+    int bucketPrefix(int bucket) const {
+        int sum = 0;
+        for (int i = bucket; i > 0; i -= i & -i) {
+            sum += bucketTree[i];
+        }
+        return sum;
+    }
+};
+
+#endif // PENDING_READ_SET_H
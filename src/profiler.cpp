@@ -0,0 +1,94 @@
+#include "profiler.h"
+
+#ifdef ENABLE_PROFILING
+
+#include <chrono>
+#include <cstdio>
+
+Profiler profiler;
+
+static const char* const PROFILE_PHASE_NAMES[PROFILE_PHASE_COUNT] = {
+    "delete", "createObject", "allocateRead", "generateTasks", "executeTasks", "updateStatus", "output"
+};
+
+static long long steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::Profiler()
+    : sliceCycles{}, totalCycles{}, maxCycles{}, histogram{}, sliceCount(0),
+      startCycles(now()), startNanos(steadyNanos()) {}
+
+Profiler::~Profiler() {
+    dump();
+}
+
+void Profiler::endSlice() {
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        uint64_t cycles = sliceCycles[phase];
+        int bucket = cycles == 0 ? 0 : 64 - __builtin_clzll(cycles);
+        if (bucket >= BUCKET_COUNT) {
+            bucket = BUCKET_COUNT - 1;
+        }
+        histogram[phase][bucket]++;
+        totalCycles[phase] += cycles;
+        if (cycles > maxCycles[phase]) {
+            maxCycles[phase] = cycles;
+        }
+        sliceCycles[phase] = 0;
+    }
+    sliceCount++;
+}
+
+void Profiler::dump() const {
+    if (sliceCount == 0) {
+        return;
+    }
+
+    // 用程序运行期间的墙钟时间换算周期数
+    uint64_t elapsedCycles = now() - startCycles;
+    long long elapsedNanos = steadyNanos() - startNanos;
+    double nanosPerCycle = elapsedCycles > 0 ? static_cast<double>(elapsedNanos) / elapsedCycles : 0.0;
+
+    // 按直方图估计分位数（取桶的上界）
+    auto percentile = [this](int phase, double p) -> uint64_t {
+        uint64_t target = static_cast<uint64_t>(p * sliceCount);
+        uint64_t seen = 0;
+        for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            seen += histogram[phase][bucket];
+            if (seen > target) {
+                return bucket == 0 ? 0 : (1ull << bucket);
+            }
+        }
+        return 1ull << (BUCKET_COUNT - 1);
+    };
+
+    std::fprintf(stderr, "=== profile (%llu slices, %.3f ns/cycle) ===\n",
+                 static_cast<unsigned long long>(sliceCount), nanosPerCycle);
+    std::fprintf(stderr, "%-14s %12s %12s %12s %12s %12s %12s\n",
+                 "phase", "total(ms)", "mean(cyc)", "p50(cyc)", "p90(cyc)", "p99(cyc)", "max(cyc)");
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        std::fprintf(stderr, "%-14s %12.3f %12llu %12llu %12llu %12llu %12llu\n",
+                     PROFILE_PHASE_NAMES[phase],
+                     totalCycles[phase] * nanosPerCycle / 1e6,
+                     static_cast<unsigned long long>(totalCycles[phase] / sliceCount),
+                     static_cast<unsigned long long>(percentile(phase, 0.50)),
+                     static_cast<unsigned long long>(percentile(phase, 0.90)),
+                     static_cast<unsigned long long>(percentile(phase, 0.99)),
+                     static_cast<unsigned long long>(maxCycles[phase]));
+    }
+
+    // 每个阶段的直方图，只输出非空的桶
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        std::fprintf(stderr, "%s histogram (cycles < 2^k : slices):", PROFILE_PHASE_NAMES[phase]);
+        for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            if (histogram[phase][bucket] != 0) {
+                std::fprintf(stderr, " %d:%u", bucket, histogram[phase][bucket]);
+            }
+        }
+        std::fprintf(stderr, "\n");
+    }
+}
+
+#endif // ENABLE_PROFILING
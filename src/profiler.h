@@ -0,0 +1,102 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/**
+ * 热点路径计时
+ *
+ * 使用周期计数器统计每个时间片中各阶段的耗时，按时间片记入固定桶的直方图，程序退出时输出到标准错误。
+ * 只有定义了 ENABLE_PROFILING 时才会编译，否则所有宏展开为空语句。
+ *
+ *   PROFILE_SCOPE(phase)  统计当前作用域的耗时，计入指定阶段
+ *   PROFILE_END_SLICE()   时间片结束，将本时间片各阶段累计耗时记入直方图
+ */
+
+// 计时的阶段
+enum ProfilePhase {
+    PROFILE_DELETE = 0,           // 删除事件处理
+    PROFILE_CREATE_OBJECT = 1,    // ObjectManager::createObject / allocateReplicas
+    PROFILE_ALLOCATE_READ = 2,    // ReadRequestManager::allocateReadRequests
+    PROFILE_GENERATE_TASKS = 3,   // DiskHeadManager::generateTasks
+    PROFILE_EXECUTE_TASKS = 4,    // DiskHeadManager::executeTasks
+    PROFILE_UPDATE_STATUS = 5,    // ReadRequestManager::updateAllRequestsStatus
+    PROFILE_OUTPUT = 6,           // 输出格式化与写出
+    PROFILE_PHASE_COUNT = 7
+};
+
+#ifdef ENABLE_PROFILING
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+class Profiler {
+public:
+    // 直方图桶数：第k个桶统计耗时在 [2^(k-1), 2^k) 个周期内的时间片
+    static constexpr int BUCKET_COUNT = 48;
+
+    Profiler();
+    ~Profiler();
+
+    // 读取周期计数器
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // 将一段耗时计入当前时间片的指定阶段
+    void add(ProfilePhase phase, uint64_t cycles) { sliceCycles[phase] += cycles; }
+
+    // 时间片结束
+    void endSlice();
+
+    // 输出统计结果
+    void dump() const;
+
+private:
+    uint64_t sliceCycles[PROFILE_PHASE_COUNT];                 // 当前时间片各阶段累计周期数
+    uint64_t totalCycles[PROFILE_PHASE_COUNT];                 // 各阶段总周期数
+    uint64_t maxCycles[PROFILE_PHASE_COUNT];                   // 各阶段单个时间片最大周期数
+    uint32_t histogram[PROFILE_PHASE_COUNT][BUCKET_COUNT];     // 各阶段每时间片耗时直方图
+    uint64_t sliceCount;                                       // 已统计的时间片数
+
+    // 用于将周期数换算为时间
+    uint64_t startCycles;
+    long long startNanos;
+};
+
+extern Profiler profiler;
+
+// 作用域计时器
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfilePhase phase) : phase(phase), start(Profiler::now()) {}
+    ~ProfileScope() { profiler.add(phase, Profiler::now() - start); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfilePhase phase;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(phase)
+#define PROFILE_END_SLICE() profiler.endSlice()
+
+#else
+
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_END_SLICE() ((void)0)
+
+#endif // ENABLE_PROFILING
+
+#endif // PROFILER_H
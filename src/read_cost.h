@@ -0,0 +1,88 @@
+#ifndef READ_COST_H
+#define READ_COST_H
+
+/**
+ * Read 动作令牌消耗的衰减状态机
+ *
+ * 非连续读取时 Read 消耗64个令牌，连续读取时每次消耗 max(16, ceil(上一次 * 0.8))，
+ * 即 64 -> 52 -> 42 -> 34 -> 28 -> 23 -> 19 -> 16 -> 16 ...
+ * 状态 s 表示下一次 Read 的消耗为 READ_COST_BY_STATE[s]，Read 后进入 s+1（最多到7），
+ * 其他动作后回到状态0。下面的表在编译期生成，任意长度的连续读取消耗都可以 O(1) 求出，不需要浮点运算。
+ */
+
+// 衰减状态数量
+constexpr int READ_DECAY_STATES = 8;
+
+// 最低的 Read 消耗
+constexpr int MIN_READ_COST = 16;
+
+// 各状态下 Read 的令牌消耗
+constexpr int READ_COST_BY_STATE[READ_DECAY_STATES] = {64, 52, 42, 34, 28, 23, 19, 16};
+
+struct ReadCostTables {
+    // chainCost[s][k]: 从状态s开始连续读取k次（k <= 8）的总消耗
+    int chainCost[READ_DECAY_STATES][READ_DECAY_STATES + 1];
+    // stateAfterCost[c]: 上一次 Read 消耗c个令牌时，下一次 Read 所处的状态
+    int stateAfterCost[65];
+
+    constexpr ReadCostTables() : chainCost(), stateAfterCost() {
+        for (int s = 0; s < READ_DECAY_STATES; s++) {
+            chainCost[s][0] = 0;
+            for (int k = 0; k < READ_DECAY_STATES; k++) {
+                int state = s + k < READ_DECAY_STATES - 1 ? s + k : READ_DECAY_STATES - 1;
+                chainCost[s][k + 1] = chainCost[s][k] + READ_COST_BY_STATE[state];
+            }
+        }
+        for (int cost = 0; cost <= 64; cost++) {
+            // ceil(cost * 0.8) = (4 * cost + 4) / 5
+            int next = (cost * 4 + 4) / 5;
+            int state = 0;
+            while (state < READ_DECAY_STATES - 1 && READ_COST_BY_STATE[state] > next) {
+                state++;
+            }
+            stateAfterCost[cost] = cost == 0 ? 0 : state;
+        }
+    }
+};
+
+inline constexpr ReadCostTables READ_COST_TABLES{};
+
+/**
+ * 上一个动作之后下一次 Read 所处的状态
+ * 参数 lastReadCost: 上一个动作为 Read 时为其消耗，否则为0
+ */
+constexpr int readStateAfterCost(int lastReadCost) {
+    return lastReadCost > 64 ? 0 : READ_COST_TABLES.stateAfterCost[lastReadCost > 0 ? lastReadCost : 0];
+}
+
+// 状态s下连续读取k次后所处的状态
+constexpr int readStateAfter(int s, int k) {
+    return s + k < READ_DECAY_STATES - 1 ? s + k : READ_DECAY_STATES - 1;
+}
+
+// 从状态s开始连续读取k次的总消耗
+constexpr int readChainCost(int s, int k) {
+    return k <= READ_DECAY_STATES
+        ? READ_COST_TABLES.chainCost[s][k]
+        : READ_COST_TABLES.chainCost[s][READ_DECAY_STATES] + (k - READ_DECAY_STATES) * MIN_READ_COST;
+}
+
+// 从状态s开始，tokens个令牌内最多能连续读取的次数
+constexpr int maxReadsWithin(int s, int tokens) {
+    const int* chain = READ_COST_TABLES.chainCost[s];
+    if (tokens >= chain[READ_DECAY_STATES]) {
+        return READ_DECAY_STATES + (tokens - chain[READ_DECAY_STATES]) / MIN_READ_COST;
+    }
+    int k = 0;
+    while (chain[k + 1] <= tokens) {
+        k++;
+    }
+    return k;
+}
+
+// 从状态s开始，总消耗首次超过limit（limit >= 0）所需的连续读取次数
+constexpr int minReadsExceeding(int s, int limit) {
+    return maxReadsWithin(s, limit) + 1;
+}
+
+#endif // READ_COST_H
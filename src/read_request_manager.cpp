@@ -1,23 +1,157 @@
 #include "read_request_manager.h"
+#include <cassert>
 #include <climits>
 #include <iostream>
 #include "constants.h" 
+#include "fast_io.h"
+#include "profiler.h"
 #include <algorithm>
 #include <cmath>
 
 ReadRequestManager::ReadRequestManager(ObjectManager& objMgr, DiskHeadManager& diskMgr)
-    : objectManager(objMgr), diskHeadManager(diskMgr) {
+    : objectManager(objMgr), diskHeadManager(diskMgr), processingRequestCount(0),
+      replicaSelectPolicy(REPLICA_SELECT_BALANCED), lateBinding(false), admissionLimit(DEFAULT_ADMISSION_LIMIT),
+      rejectedRequestCount(0), expiredRequestCount(0) {
+    expiryWheel.init(EXTRA_TIME);
 
     // diskLoadCounter.resize(diskHeadManager.getDiskCount() + 1, 0); // 假设最大磁盘ID为99
 }
 
+void ReadRequestManager::addBlockDemand(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks) {
+    for (unsigned int blocks = unreadBlocks; blocks != 0; blocks &= blocks - 1) {
+        int blockIndex = __builtin_ctz(blocks);
+        int selectedReplica = request.getReplica(blockIndex);
+        for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+            int diskId = obj.getReplica(replicaIndex).diskId;
+            int unitPos = obj.getUnitPosition(replicaIndex, blockIndex);
+            if (replicaIndex == selectedReplica) {
+                diskHeadManager.addReadRequest(diskId, unitPos);
+            } else if (request.lateBound) {
+                diskHeadManager.addSoftReadRequest(diskId, unitPos);
+            }
+        }
+    }
+}
+
+void ReadRequestManager::releaseBlockDemand(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks) {
+    for (unsigned int blocks = unreadBlocks; blocks != 0; blocks &= blocks - 1) {
+        int blockIndex = __builtin_ctz(blocks);
+        int selectedReplica = request.getReplica(blockIndex);
+        for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+            int diskId = obj.getReplica(replicaIndex).diskId;
+            int unitPos = obj.getUnitPosition(replicaIndex, blockIndex);
+            if (replicaIndex == selectedReplica) {
+                diskHeadManager.cancelReadRequest(diskId, unitPos);
+            } else if (request.lateBound) {
+                diskHeadManager.cancelSoftReadRequest(diskId, unitPos);
+            }
+        }
+    }
+}
+
+void ReadRequestManager::withdrawBlockDemand(const Object& obj, int block) {
+    for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+        diskHeadManager.withdrawReadRequest(obj.getReplica(replicaIndex).diskId, obj.getUnitPosition(replicaIndex, block));
+    }
+}
+
+int ReadRequestManager::findDemandedReplica(const Object& obj, int block) const {
+    int bestReplica = -1;
+    int bestDemand = 0;
+    for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+        int demand = diskHeadManager.getReadDemand(obj.getReplica(replicaIndex).diskId, obj.getUnitPosition(replicaIndex, block));
+        if (demand > bestDemand) {
+            bestDemand = demand;
+            bestReplica = replicaIndex;
+        }
+    }
+    return bestReplica;
+}
+
+int ReadRequestManager::estimateReplicaTokens(const Object& obj, int replicaIndex, unsigned int blocks) const {
+    int units[MAX_REQUEST_BLOCKS];
+    int count = 0;
+    for (; blocks != 0; blocks &= blocks - 1) {
+        units[count++] = obj.getUnitPosition(replicaIndex, __builtin_ctz(blocks));
+    }
+    return diskHeadManager.estimateTokensToReadUnits(obj.getReplica(replicaIndex).diskId, units, count);
+}
+
+int ReadRequestManager::selectReplica(const Object& obj, unsigned int blocks) const {
+    // 每个副本预计读完这些块的令牌数
+    int replicaTokens[REP_NUM];
+    for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+        replicaTokens[replicaIndex] = estimateReplicaTokens(obj, replicaIndex, blocks);
+    }
+    if (replicaSelectPolicy == REPLICA_SELECT_EARLIEST) {
+        return static_cast<int>(std::min_element(replicaTokens, replicaTokens + REP_NUM) - replicaTokens);
+    }
+
+    // 每个副本所在磁盘的待读取单元数，以及副本到最近待读取单元的距离
+    int replicaLoads[REP_NUM];
+    int replicaDistances[REP_NUM];
+    for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+        const StorageUnit& replica = obj.getReplica(replicaIndex);
+        replicaLoads[replicaIndex] = diskHeadManager.getHeadReadLoad(replica.diskId);
+        replicaDistances[replicaIndex] = INT_MAX;
+        for (const auto& blockPair : replica.blockLists) {
+            int distance = diskHeadManager.getDistanceOfNearestReadUnit(replica.diskId, blockPair.first, blockPair.second);
+            replicaDistances[replicaIndex] = std::min(replicaDistances[replicaIndex], distance);
+        }
+    }
+
+    // 负载差距大于55%时选择负载最小的磁盘
+    int minLoad = *std::min_element(replicaLoads, replicaLoads + REP_NUM);
+    int maxLoad = *std::max_element(replicaLoads, replicaLoads + REP_NUM);
+    if (maxLoad > 0 && static_cast<double>(maxLoad - minLoad) / maxLoad > 0.55) {
+        return static_cast<int>(std::min_element(replicaLoads, replicaLoads + REP_NUM) - replicaLoads);
+    }
+
+    // 否则选择距离最近的副本，使读取集中；距离相同时选择预计最早读完的副本
+    int selectedReplicaIndex = 0;
+    for (int replicaIndex = 1; replicaIndex < REP_NUM; replicaIndex++) {
+        if (replicaDistances[replicaIndex] < replicaDistances[selectedReplicaIndex] ||
+            (replicaDistances[replicaIndex] == replicaDistances[selectedReplicaIndex] &&
+             replicaTokens[replicaIndex] < replicaTokens[selectedReplicaIndex])) {
+            selectedReplicaIndex = replicaIndex;
+        }
+    }
+    return selectedReplicaIndex;
+}
+
+bool ReadRequestManager::admitRequest(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks) const {
+    // 按选择的副本分组
+    unsigned int replicaBlocks[REP_NUM] = {};
+    bool needsNewUnit = false;
+    for (unsigned int blocks = unreadBlocks; blocks != 0; blocks &= blocks - 1) {
+        int blockIndex = __builtin_ctz(blocks);
+        int replicaIndex = request.getReplica(blockIndex);
+        replicaBlocks[replicaIndex] |= 1u << blockIndex;
+        if (diskHeadManager.getReadDemand(obj.getReplica(replicaIndex).diskId, obj.getUnitPosition(replicaIndex, blockIndex)) == 0) {
+            needsNewUnit = true;
+        }
+    }
+    // 所有块都已有其他请求在读取时不额外消耗令牌，总是接受
+    if (!needsNewUnit) {
+        return true;
+    }
+    int predictedSlices = 0;
+    for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
+        if (replicaBlocks[replicaIndex] != 0) {
+            int tokens = estimateReplicaTokens(obj, replicaIndex, replicaBlocks[replicaIndex]);
+            predictedSlices = std::max(predictedSlices, diskHeadManager.tokensToSlices(tokens));
+        }
+    }
+    return predictedSlices <= admissionLimit;
+}
+
 bool ReadRequestManager::addReadRequest(int requestId, int objectId) {
     // 获取对象信息
     auto obj = objectManager.getObject(objectId);
 
 #ifndef NDEBUG
     // 检查请求ID是否已存在
-    if (requests.find(requestId) != requests.end()) {
+    if (requests.find(requestId) != nullptr) {
         std::cout << "警告: 请求ID " << requestId << " 已存在" << std::endl;
         return false;
     }
@@ -28,21 +162,22 @@ bool ReadRequestManager::addReadRequest(int requestId, int objectId) {
         return false;
     }
 #endif
+    // 对象块数不超过 MAX_OBJECT_SIZE，位掩码宽度由 request_table.h 中的 static_assert 保证
+    assert(obj->getSize() <= MAX_OBJECT_SIZE);
     
     // 创建新的读取请求
-    ReadRequest request(requestId, objectId);
+    ReadRequest& request = requests.insert(requestId, objectId);
     request.status = REQUEST_PENDING;
     request.startTimeSlice = currentTimeSlice;
 
-    // 更新总剩余单元数
-    request.totalRemainingUnits = obj->getSize();
-
-    // 保存请求
-    requests[requestId] = request;
     pendingRequests.push_back(requestId);
     
-    // 更新对象到请求的映射
-    objectToRequests[objectId].insert(requestId);
+    // 加入对象的等待队列
+    auto progressIt = objectProgress.try_emplace(objectId, obj->getSize()).first;
+    request.progressTicket = progressIt->second.addWaiter(requestId);
+
+    // 登记到期时间片
+    expiryWheel.add(currentTimeSlice + EXTRA_TIME, requestId);
 
     return true;
 }
@@ -59,14 +194,14 @@ bool ReadRequestManager::allocateReadRequests() {
         int requestId = pendingRequests.back();
         pendingRequests.pop_back();
         
-        auto requestIt = requests.find(requestId);
+        ReadRequest* requestPtr = requests.find(requestId);
 #ifndef NDEBUG
-        if (requestIt == requests.end()) {
+        if (requestPtr == nullptr) {
             continue; // 跳过不存在的请求
         }
 #endif
         
-        ReadRequest& request = requestIt->second;
+        ReadRequest& request = *requestPtr;
         
         // 获取对象信息
         auto obj = objectManager.getObject(request.objectId);
@@ -78,237 +213,102 @@ bool ReadRequestManager::allocateReadRequests() {
         }
 #endif
         
-        // 初始化请求的磁盘单元信息
-        if (request.remainingUnits.empty()) {
-            // 查找是否有处理中的请求正在读取相同的对象
-            bool hasProcessingRequest = false;
-
-            // 请求读取对象的待读取的索引，初始化为0到object.size()
-            std::unordered_set<int> unprocessedBlockIndex;
-            for (int i = 0; i < obj->getSize(); i++) {
-                unprocessedBlockIndex.insert(i);
-            }
-            // 待处理的磁盘单元索引 <磁盘id, 单元索引>
-            std::vector<std::pair<int, int>> processedDiskUnit;
-
-            auto objectRequestsIt = objectToRequests.find(request.objectId);
-            if (objectRequestsIt != objectToRequests.end()) {
-                // 检查与该对象关联的所有请求
-                for (int otherRequestId : objectRequestsIt->second) {
-                    // 跳过当前请求自身
-                    if (otherRequestId == requestId) {
-                        continue;
-                    }
-                    
-                    auto otherRequestIt = requests.find(otherRequestId);
-                    if (otherRequestIt != requests.end() && otherRequestIt->second.status == REQUEST_PROCESSING) {
-                        // 找到一个处理中的相同对象请求
-                        hasProcessingRequest = true;
-                        const ReadRequest& otherRequest = otherRequestIt->second;
-                        
-                        // 对于每个磁盘，记录正在处理的单元
-                        for (const auto& [diskId, units] : otherRequest.remainingUnits) {
-                            for (int unitPos : units) {
-                                int blockIndex = diskHeadManager.getDiskManager().getBlockStatus(diskId, unitPos);
-                                if (unprocessedBlockIndex.erase(blockIndex) > 0) {
-                                    processedDiskUnit.push_back(std::make_pair(diskId, unitPos));
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            
-            if (hasProcessingRequest && unprocessedBlockIndex.empty()) {
-
-                for (auto [diskId, unitPos] : processedDiskUnit) {
-                    request.remainingUnits[diskId].insert(unitPos);
-                }
-    
+        ObjectReadProgress& progress = objectProgress.find(request.objectId)->second;
+        unsigned int unreadBlocks = progress.getUnreadBlocks(request.progressTicket);
+
+        // 其他处理中的请求正在读取的块，复用其副本
+        unsigned int unassignedBlocks = 0;
+        for (unsigned int blocks = unreadBlocks; blocks != 0; blocks &= blocks - 1) {
+            int blockIndex = __builtin_ctz(blocks);
+            int replicaIndex = findDemandedReplica(*obj, blockIndex);
+            if (replicaIndex != -1) {
+                request.setReplica(blockIndex, replicaIndex);
             } else {
-                // 没有处理中的相同对象请求，使用新的逻辑选择最优副本
-                
-                // 存储每个副本的评估信息 <副本索引, <距离评分, 磁盘ID, 磁盘负载>>
-                std::vector<std::tuple<int, int, int, int>> replicaScores;
-                
-                // 检查每个副本
-                for (int replicaIndex = 0; replicaIndex < REP_NUM; replicaIndex++) {
-                    const StorageUnit& replica = obj->getReplica(replicaIndex);
-                    int diskId = replica.diskId;
-                    
-                    // 获取该磁盘的未读取单元数
-                    double diskLoad = diskHeadManager.getHeadReadLoad(diskId);
-                    
-                    // 计算副本到最近读取单元的距离
-                    int totalDistance = INT_MAX;
-                    for (const auto& blockPair : replica.blockLists) {
-                        int startPos = blockPair.first;
-                        int length = blockPair.second;
-                        
-                        // 使用DiskHeadManager的方法获取到最近读取单元的距离
-                        int distance = diskHeadManager.getDistanceOfNearestReadUnit(diskId, startPos, length);
-                        totalDistance = std::min(totalDistance, distance);
-                    }
-                    
-                    // 保存副本的评分信息
-                    replicaScores.push_back(std::make_tuple(replicaIndex, totalDistance, diskId, diskLoad));
-                }
-                
-                // 找出负载最小和最大的磁盘
-                int minLoad = INT_MAX;
-                int maxLoad = 0;
-                
-                for (const auto& [replicaIndex, distance, diskId, load] : replicaScores) {
-                    minLoad = std::min(minLoad, load);
-                    maxLoad = std::max(maxLoad, load);
-                }
-                
-                // 计算负载差距
-                double loadDifference = (double)(maxLoad - minLoad) / (double)(maxLoad);
-                
-                // 选择要使用的副本
-                int selectedReplicaIndex = -1;
-                
-                if (loadDifference > 0.55) {
-                    // 负载差距大于60%，选择负载最小的磁盘
-                    int minLoadIndex = -1;
-                    int currentMinLoad = INT_MAX;
-                    
-                    for (size_t i = 0; i < replicaScores.size(); i++) {
-                        const auto& [replicaIndex, distance, diskId, load] = replicaScores[i];
-                        if (load < currentMinLoad) {
-                            currentMinLoad = load;
-                            minLoadIndex = i;
-                        }
-                    }
-                    
-                    if (minLoadIndex != -1) {
-                        selectedReplicaIndex = std::get<0>(replicaScores[minLoadIndex]);
-                    }
-                } else {
-                    // 负载差距不大，选择距离最近的副本
-                    int minDistanceIndex = -1;
-                    int currentMinDistance = INT_MAX;
-                    
-                    for (size_t i = 0; i < replicaScores.size(); i++) {
-                        const auto& [replicaIndex, distance, diskId, load] = replicaScores[i];
-                        if (distance < currentMinDistance) {
-                            currentMinDistance = distance;
-                            minDistanceIndex = i;
-                        }
-                    }
-                    
-                    if (minDistanceIndex != -1) {
-                        selectedReplicaIndex = std::get<0>(replicaScores[minDistanceIndex]);
-                    }
-                }
-                
-                // 如果找不到有效副本，使用第一个副本（不应该发生）
-                if (selectedReplicaIndex == -1 && !replicaScores.empty()) {
-                    selectedReplicaIndex = std::get<0>(replicaScores[0]);
-                }
-                
-                // 使用选定的副本
-                const StorageUnit& unit = obj->getReplica(selectedReplicaIndex);
-                int diskId = unit.diskId;
-                
-                if (hasProcessingRequest) {
-                    for (auto [diskId, unitPos] : processedDiskUnit) {
-                        request.remainingUnits[diskId].insert(unitPos);
-                    }
-
-                    for (const auto& blockPair : unit.blockLists) {
-                        int startPos = blockPair.first;
-                        int length = blockPair.second;
-                        
-                        for (int j = 0; j < length; j++) {
-                            int unitPos = startPos + j;
-                            int blockIndex = diskHeadManager.getDiskManager().getBlockStatus(diskId, unitPos);
-                            auto it = unprocessedBlockIndex.find(blockIndex);
-                            if (it != unprocessedBlockIndex.end()) {
-                                request.remainingUnits[diskId].insert(unitPos);
-                                unprocessedBlockIndex.erase(it);
-                            }
-                        }
-                    }
+                unassignedBlocks |= 1u << blockIndex;
+            }
+        }
 
-                }
-                else {
-                    // 添加需要读取的单元位置
-                    for (const auto& blockPair : unit.blockLists) {
-                        int startPos = blockPair.first;
-                        int length = blockPair.second;
-                        
-                        for (int j = 0; j < length; j++) {
-                            int unitPos = startPos + j;
-                            request.remainingUnits[diskId].insert(unitPos);
-                        }
-                    }
-                }
+        if (unassignedBlocks != 0) {
+            // 没有其他请求正在读取的块，选择副本
+            int selectedReplicaIndex = selectReplica(*obj, unassignedBlocks);
+            
+            // 其余块从选定的副本读取
+            for (unsigned int blocks = unassignedBlocks; blocks != 0; blocks &= blocks - 1) {
+                request.setReplica(__builtin_ctz(blocks), selectedReplicaIndex);
             }
         }
         
+        // 准入控制：需要新增读取任务、且预计在 admissionLimit 个时间片内读不完的请求直接放弃
+        if (admissionLimit > 0 && !admitRequest(request, *obj, unreadBlocks)) {
+            // 请求仍留在对象的等待队列中：被顺带读完时上报完成，对象删除时上报取消
+            rejectedRequestCount++;
+            requests.erase(requestId);
+            continue;
+        }
+
         // 将请求设置为处理中
         request.status = REQUEST_PROCESSING;
-        processingRequests.insert(requestId);
+        processingRequestCount++;
         
-        // 为磁盘磁头管理器分配读取任务
-        for (auto& diskUnits : request.remainingUnits) {
-            int diskId = diskUnits.first;
-            std::set<int>& units = diskUnits.second;
-            
-            for (int unitPos : units) {
-                diskHeadManager.addReadRequest(diskId, unitPos);
-            }
-        }
+        // 为磁盘磁头管理器分配读取任务，选定副本上单元的需求数加一，延迟绑定时其他副本登记软需求
+        request.lateBound = lateBinding;
+        addBlockDemand(request, *obj, unreadBlocks);
     }
     
     return true;
 }
 
-void ReadRequestManager::updateAllRequestsStatus(const std::unordered_map<int, std::vector<int>>& readUnits) {
+void ReadRequestManager::updateAllRequestsStatus() {
     
     // 对于每个被读取的磁盘的每个单元
-    for (const auto& [diskId, units] : readUnits) {
-        for (int unitPos : units) {
+    for (int diskId = 1; diskId <= diskHeadManager.getDiskCount(); diskId++) {
+        for (int unitPos : diskHeadManager.getExecutedReads(diskId)) {
             // 使用ObjectManager获取该单元对应的对象ID
             int objectId = objectManager.getObjectIdByDiskBlock(diskId, unitPos);
             if (objectId == -1) {
                 continue; // 没有找到对应的对象，跳过
             }
             
-            // 获取与该对象关联的所有请求
-            auto objectIt = objectToRequests.find(objectId);
-            if (objectIt != objectToRequests.end()) {
-                // 更新每个关联的请求
-                for (int requestId : objectIt->second) {
-                    auto requestIt = requests.find(requestId);
-                    if (requestIt != requests.end() && requestIt->second.status == REQUEST_PROCESSING) {
-                        // 更新该请求的状态
-                        ReadRequest& request = requestIt->second;
-                        
-                        // 从剩余单元中移除已读取的单元
-                        auto& diskUnits = request.remainingUnits[diskId];
-                        if (diskUnits.erase(unitPos) == 1) {
-                            request.totalRemainingUnits--;
-                            
-                            // 检查请求是否已完成
-                            if (request.totalRemainingUnits == 0) {
-                                request.status = REQUEST_COMPLETED;
-                                processingRequests.erase(requestId);
-                                completedRequests.insert(requestId);
-                            }
-                        }
+            // 没有请求在等待该对象
+            auto progressIt = objectProgress.find(objectId);
+            if (progressIt == objectProgress.end()) {
+                continue;
+            }
+            ObjectReadProgress& progress = progressIt->second;
+            int blockIndex = diskHeadManager.getDiskManager().getBlockStatus(diskId, unitPos);
+
+            // 所有等待中的请求都已读到该块，撤销各副本上该块的读取任务
+            auto obj = objectManager.getObject(objectId);
+            withdrawBlockDemand(*obj, blockIndex);
+
+            // 推进对象的读取进度，弹出所有块都已读取的请求
+            // 已超时放弃的请求不在请求表中，完成后同样需要上报
+            progress.markBlockRead(blockIndex, [this](int requestId) {
+                ReadRequest* requestPtr = requests.find(requestId);
+                if (requestPtr != nullptr) {
+                    if (requestPtr->status == REQUEST_PROCESSING) {
+                        processingRequestCount--;
                     }
+                    requestPtr->status = REQUEST_COMPLETED;
                 }
+                completedRequests.insert(requestId);
+            });
+
+            // 对象上没有等待的请求了，移除其读取进度
+            if (!progress.hasWaiters()) {
+                objectProgress.erase(progressIt);
             }
         }
     }
 }
 
 void ReadRequestManager::executeTimeSlice() {
-    // 分配读取请求
-    allocateReadRequests();
+    // 放弃已无法得分的请求，分配读取请求
+    {
+        PROFILE_SCOPE(PROFILE_ALLOCATE_READ);
+        checkRequestsTimeout();
+        allocateReadRequests();
+    }
 
     #ifndef NDEBUG
     // 将当前时间片每个磁盘磁头的待读取单元数量写入txt
@@ -321,27 +321,39 @@ void ReadRequestManager::executeTimeSlice() {
     #endif
     
     // 重置磁盘磁头管理器时间片，生成读取任务
-    diskHeadManager.resetTimeSlice();
+    {
+        PROFILE_SCOPE(PROFILE_GENERATE_TASKS);
+        diskHeadManager.resetTimeSlice();
+    }
 
     // 打印任务队列
-    diskHeadManager.printTaskQueues();
+    {
+        PROFILE_SCOPE(PROFILE_OUTPUT);
+        diskHeadManager.printTaskQueues();
+    }
     
-    // 执行时间片并获取读取的单元
-    std::unordered_map<int, std::vector<int>> readUnits = diskHeadManager.executeTasks();
+    // 执行时间片，读取的单元保存在磁头管理器的复用缓冲区中
+    {
+        PROFILE_SCOPE(PROFILE_EXECUTE_TASKS);
+        diskHeadManager.executeTasks();
+    }
     
     // 使用高效方法更新所有请求状态
-    updateAllRequestsStatus(readUnits);
+    {
+        PROFILE_SCOPE(PROFILE_UPDATE_STATUS);
+        updateAllRequestsStatus();
+    }
     
     // 输出当前时间片完成的请求
-    if (!completedRequests.empty()) {
-        std::cout << completedRequests.size() << std::endl;
+    {
+        PROFILE_SCOPE(PROFILE_OUTPUT);
+        outputWriter.appendInt(static_cast<int>(completedRequests.size()));
+        outputWriter.append('\n');
         for (int requestId : completedRequests) {
-            std::cout << requestId << std::endl;
+            outputWriter.appendInt(requestId);
+            outputWriter.append('\n');
         }
     }
-    else {
-        std::cout << 0 << std::endl;
-    }
 
     // 清空当前时间片完成的请求记录
     resetTimeSlice();
@@ -357,51 +369,24 @@ int ReadRequestManager::getTotalRequestCount() const {
 }
 
 int ReadRequestManager::getProcessingRequestCount() const {
-    return processingRequests.size();
+    return processingRequestCount;
 }
 
 int ReadRequestManager::getCompletedRequestCount() const {
     int count = 0;
-    for (const auto& entry : requests) {
-        if (entry.second.status == REQUEST_COMPLETED) {
+    requests.forEach([&count](const ReadRequest& request) {
+        if (request.status == REQUEST_COMPLETED) {
             count++;
         }
-    }
+    });
     return count;
 }
 
 void ReadRequestManager::resetTimeSlice() {
-    // 从各种数据结构中删除已完成的请求
+    // 从各种数据结构中删除已完成的请求（已在完成时移出对象的等待队列）
     for (int requestId : completedRequests) {
-        auto requestIt = requests.find(requestId);
-// #ifndef NDEBUG
-        if (requestIt == requests.end()) {
-            continue;
-        }
-// #endif
-        
-        // 获取对象ID，以便从objectToRequests中移除引用
-        int objectId = requestIt->second.objectId;
-        
-        // 从objectToRequests中移除请求引用
-        auto objectIt = objectToRequests.find(objectId);
-
-        if (objectIt != objectToRequests.end()) {
-
-            objectIt->second.erase(requestId);
-            
-            // 如果对象没有关联的请求了，移除整个映射项
-            if (objectIt->second.empty()) {
-                objectToRequests.erase(objectId);
-            }
-
-        }
-        
-        // 从请求映射中删除请求
+        // 从请求映射中删除请求（处理中的计数已在完成时减去）
         requests.erase(requestId);
-        
-        // 确保从处理中队列也删除（虽然应该在updateRequestStatus中已经处理）
-        processingRequests.erase(requestId);
     }
     
     // 清空当前时间片完成的请求记录
@@ -411,54 +396,40 @@ void ReadRequestManager::resetTimeSlice() {
 std::vector<int> ReadRequestManager::cancelRequestsByObjectId(int objectId) {
     std::vector<int> cancelledRequests;
     
-    // 使用objectToRequests映射直接获取与对象相关的所有请求
-    auto requestsIt = objectToRequests.find(objectId);
+    // 获取对象的读取进度，其中记录了所有等待中的请求
+    auto progressIt = objectProgress.find(objectId);
 // #ifndef NDEBUG
-    if (requestsIt == objectToRequests.end()) {
+    if (progressIt == objectProgress.end()) {
         // 如果对象没有关联的请求，直接返回空向量
         objectManager.deleteObject(objectId);
         return cancelledRequests;
     }
 // #endif
 
-    // 获取与该对象关联的所有请求ID
-    std::unordered_set<int> requestIds = requestsIt->second;
+    ObjectReadProgress& progress = progressIt->second;
     
-    // 处理每个关联的请求
-    for (int requestId : requestIds) {
-        auto requestIt = requests.find(requestId);
-// #ifndef NDEBUG
-        if (requestIt == requests.end()) {
-            continue;
-        }
-// #endif
-
-        ReadRequest& request = requestIt->second;
-        
+    // 处理每个等待中的请求
+    // 已超时放弃的请求不在请求表中，但仍需上报取消
+    progress.forEachWaiter([this, &cancelledRequests](int requestId) {
         // 将请求ID添加到返回结果中
         cancelledRequests.push_back(requestId);
         
-        // 从处理中队列移除
-        processingRequests.erase(requestId);
-        
-        // 遍历请求中所有磁盘的读取单元
-        for (const auto& diskUnits : request.remainingUnits) {
-            int diskId = diskUnits.first;
-            const std::set<int>& units = diskUnits.second;
-            
-            // 取消磁盘头管理器中的所有读取请求
-            for (int unitPos : units) {
-                diskHeadManager.cancelReadRequest(diskId, unitPos);
-                
-            }
+        // 处理中的请求减少计数，然后从请求列表中移除此请求
+        const ReadRequest* requestPtr = requests.find(requestId);
+        if (requestPtr != nullptr && requestPtr->status == REQUEST_PROCESSING) {
+            processingRequestCount--;
         }
-        
-        // 从请求列表中移除此请求
         requests.erase(requestId);
+    });
+    
+    // 取消磁盘头管理器中该对象所有块的读取任务
+    auto obj = objectManager.getObject(objectId);
+    for (int blockIndex = 0; blockIndex < progress.getBlockCount(); blockIndex++) {
+        withdrawBlockDemand(*obj, blockIndex);
     }
     
-    // 从映射中删除该对象ID
-    objectToRequests.erase(objectId);
+    // 移除该对象的读取进度
+    objectProgress.erase(progressIt);
 
     // 删除对象
     objectManager.deleteObject(objectId);
@@ -470,48 +441,23 @@ int ReadRequestManager::getPendingRequestCount() const {
     return pendingRequests.size();
 } 
 
-//负分
 void ReadRequestManager::checkRequestsTimeout() {
-
-    // 检查所有更新中的请求，删除超时的请求
-    std::unordered_set<int> timeoutRequests;
-    for (const auto& processingRequest : processingRequests) {
-        // 如果请求正在处理中，检查是否超时
-        auto requestIt = requests.find(processingRequest);
-        ReadRequest& request = requestIt->second;
-        // 如果请求的时间片和当前时间片差距大于等于105，则标记为超时
-        if (currentTimeSlice - request.startTimeSlice >= 90) {
-            timeoutRequests.insert(processingRequest);
+    // 只处理在当前时间片到期的请求：延迟达到 EXTRA_TIME 后完成已不再得分
+    expiryWheel.popExpired(currentTimeSlice, [this](int requestId) {
+        ReadRequest* requestPtr = requests.find(requestId);
+        if (requestPtr == nullptr || requestPtr->status != REQUEST_PROCESSING) {
+            return; // 已完成或已取消
         }
-        
-    }
-    
-    // 删除所有超时的请求的磁盘读取
-    for (int requestId : timeoutRequests) {
-        auto requestIt = requests.find(requestId);
-        if (requestIt != requests.end()) {
-            // 获取对象ID，以便从objectToRequests中移除引用
-            int objectId = requestIt->second.objectId;     
-            // 从objectToRequests中移除请求引用
-            auto objectIt = objectToRequests.find(objectId);
-            if (objectIt != objectToRequests.end() && 
-                std::all_of(objectIt->second.begin(), objectIt->second.end(), 
-                           [&timeoutRequests](int reqId) { return timeoutRequests.count(reqId) > 0; })) {
-                
-                for (const auto& diskUnits : requestIt->second.remainingUnits) {
-                    int diskId = diskUnits.first;
-                    const std::set<int>& units = diskUnits.second;
-                    
-                    // 取消磁盘头管理器中的所有读取请求
-                    for (int unitPos : units) {
-                        diskHeadManager.cancelReadRequest(diskId, unitPos);
-                        
-                    }
-                }
 
-            }
+        // 释放该请求在未读取块上的需求
+        const ObjectReadProgress& progress = objectProgress.find(requestPtr->objectId)->second;
+        auto obj = objectManager.getObject(requestPtr->objectId);
+        releaseBlockDemand(*requestPtr, *obj, progress.getUnreadBlocks(requestPtr->progressTicket));
 
-        }
-    }
+        // 请求仍留在对象的等待队列中：被顺带读完时上报完成，对象删除时上报取消
+        processingRequestCount--;
+        requests.erase(requestId);
+        expiredRequestCount++;
+    });
 }
 
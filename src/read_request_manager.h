@@ -13,25 +13,14 @@
 #include "object_manager.h"
 #include "disk_head_manager.h"
 #include "constants.h"
+#include "request_table.h"
+#include "object_read_progress.h"
+#include "timing_wheel.h"
 
-// 读取请求状态
-enum RequestStatus {
-    REQUEST_PENDING,     // 等待处理
-    REQUEST_PROCESSING,  // 处理中
-    REQUEST_COMPLETED    // 已完成
-};
-
-// 读取请求数据结构
-struct ReadRequest {
-    int requestId;                                  // 请求ID
-    int objectId;                                   // 读取的对象ID
-    RequestStatus status;                           // 请求状态
-    std::unordered_map<int, std::set<int>> remainingUnits; // 每个磁盘上需要读取的单元 (磁盘ID -> 单元位置集合)
-    int totalRemainingUnits;                        // 总剩余需要读取的单元数
-    int startTimeSlice;                              // 请求开始时间片
-    
-    ReadRequest() : requestId(0), objectId(0), status(REQUEST_PENDING), totalRemainingUnits(0) {}
-    ReadRequest(int reqId, int objId) : requestId(reqId), objectId(objId), status(REQUEST_PENDING), totalRemainingUnits(0) {}
+// 副本选择策略
+enum ReplicaSelectPolicy {
+    REPLICA_SELECT_BALANCED = 0,  // 负载差距大时选负载最小的磁盘，否则选离已有待读取单元最近的副本，预计完成时间用于打破平局
+    REPLICA_SELECT_EARLIEST = 1   // 选择预计最早读完的副本
 };
 
 // 读取请求管理器类
@@ -40,16 +29,61 @@ private:
     ObjectManager& objectManager;                        // 对象管理器引用
     DiskHeadManager& diskHeadManager;                    // 磁盘头管理器引用
     
-    std::unordered_map<int, ReadRequest> requests;       // 所有请求 (请求ID -> 请求)
+    RequestTable requests;                               // 所有在途请求 (按请求ID索引)
     std::vector<int> pendingRequests;                    // 等待处理的请求ID列表
-    std::unordered_set<int> processingRequests;          // 正在处理的请求ID集合
+    int processingRequestCount;                          // 正在处理的请求数（状态记录在请求表中）
     std::unordered_set<int> completedRequests;           // 当前时间片完成的请求ID集合
     
-    // 对象ID到请求ID的映射，用于快速找到与对象相关的读取请求
-    std::unordered_map<int, std::unordered_set<int>> objectToRequests;
+    // 有请求等待的对象的读取进度 (对象ID -> 进度)
+    std::unordered_map<int, ObjectReadProgress> objectProgress;
+
+    // 副本选择策略
+    ReplicaSelectPolicy replicaSelectPolicy;
+
+    // 延迟绑定：在选定副本之外的其他副本上登记软需求，由先经过的磁头顺带读取
+    bool lateBinding;
+
+    // 准入上限：预计读取时间超过该时间片数的新请求直接放弃，不大于0时全部接受
+    int admissionLimit;
+    int rejectedRequestCount;                            // 准入放弃的请求数
+
+    // 按到期时间片登记的请求，以及已放弃的请求数
+    TimingWheel expiryWheel;
+    int expiredRequestCount;
+
+
+    // 为对象中 blocks 对应的各块选择读取的副本
+    int selectReplica(const Object& obj, unsigned int blocks) const;
+
+    // 判断请求是否准入：需要新增读取任务时，按各块所在磁头的预计读取时间判断
+    bool admitRequest(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks) const;
+
+    // 请求的未读取块上选定副本的需求数加一，开启延迟绑定时其他副本的软需求数加一
+    void addBlockDemand(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks);
+
+    // 释放请求在未读取块上登记的需求
+    void releaseBlockDemand(const ReadRequest& request, const Object& obj, unsigned int unreadBlocks);
+
+    // 撤销所有副本上对象第 block 块的读取任务（清除其需求数和软需求数）
+    void withdrawBlockDemand(const Object& obj, int block);
+
+    // 正在读取对象第 block 块的副本（需求数最多者），没有返回 -1
+    int findDemandedReplica(const Object& obj, int block) const;
 
 public:
     ReadRequestManager(ObjectManager& objMgr, DiskHeadManager& diskMgr);
+
+    // 默认的准入上限（时间片数），与得分窗口 EXTRA_TIME 相同：过载时更小的上限放弃了仍能得分的请求
+    static constexpr int DEFAULT_ADMISSION_LIMIT = EXTRA_TIME;
+
+    // 设置副本选择策略
+    void setReplicaSelectPolicy(ReplicaSelectPolicy policy) { replicaSelectPolicy = policy; }
+
+    // 开启或关闭延迟绑定，只影响之后分配的请求
+    void setLateBinding(bool enabled) { lateBinding = enabled; }
+
+    // 设置准入上限，不大于0时关闭准入控制
+    void setAdmissionLimit(int limit) { admissionLimit = limit; }
     
     // 添加读取请求
     bool addReadRequest(int requestId, int objectId);
@@ -57,13 +91,13 @@ public:
     // 分配读取请求（将等待的请求变为处理中）
     bool allocateReadRequests();
     
-    // 更新请求状态
-    void updateAllRequestsStatus(const std::unordered_map<int, std::vector<int>>& readUnits);
+    // 根据各磁盘本时间片读取的单元更新请求状态
+    void updateAllRequestsStatus();
     
     // 取消某个对象的所有读取请求
     std::vector<int> cancelRequestsByObjectId(int objectId);
 
-    // 检查所有更新中的请求，删除超时的请求
+    // 放弃在当前时间片到期（延迟达到 EXTRA_TIME、完成也不再得分）的请求，释放其读取需求
     void checkRequestsTimeout();
     
     // 执行一个时间片
@@ -80,6 +114,12 @@ public:
     int getProcessingRequestCount() const;
     int getCompletedRequestCount() const;
     int getPendingRequestCount() const;
+    int getExpiredRequestCount() const { return expiredRequestCount; }
+    int getRejectedRequestCount() const { return rejectedRequestCount; }
+
+    // 估计副本 replicaIndex 所在磁头读完对象中 blocks（位掩码）对应各块所需的令牌数，
+    // 按磁头位置、途中的待读取单元、衰减状态和G估计，可用 DiskHeadManager::tokensToSlices 换算为时间片
+    int estimateReplicaTokens(const Object& obj, int replicaIndex, unsigned int blocks) const;
     
 };
 
@@ -0,0 +1,39 @@
+#include "replay_stats.h"
+#include <iomanip>
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {
+    "preprocess", "timestamp", "delete", "write", "read"
+};
+
+ReplayStats::ReplayStats() : phaseNanos{}, sliceCount(0) {
+    phaseStart = Clock::now();
+}
+
+void ReplayStats::report(std::ostream& out, size_t outputBytes) const {
+    long long totalNanos = 0;
+    long long sliceNanos = 0;
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        totalNanos += phaseNanos[phase];
+        if (phase != PHASE_PREPROCESS) {
+            sliceNanos += phaseNanos[phase];
+        }
+    }
+
+    out << "=== replay ===\n";
+    out << std::left << std::setw(12) << "phase" << std::right
+        << std::setw(14) << "total(ms)" << std::setw(14) << "per-slice(us)" << std::setw(10) << "share" << "\n";
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        double totalMs = phaseNanos[phase] / 1e6;
+        double perSliceUs = (phase == PHASE_PREPROCESS || sliceCount == 0) ? 0.0 : phaseNanos[phase] / 1e3 / sliceCount;
+        double share = totalNanos > 0 ? 100.0 * phaseNanos[phase] / totalNanos : 0.0;
+        out << std::left << std::setw(12) << PHASE_NAMES[phase] << std::right << std::fixed
+            << std::setprecision(3) << std::setw(14) << totalMs
+            << std::setprecision(3) << std::setw(14) << perSliceUs
+            << std::setprecision(1) << std::setw(9) << share << "%\n";
+    }
+
+    double sliceSeconds = sliceNanos / 1e9;
+    out << std::setprecision(3);
+    out << "slices: " << sliceCount << ", total: " << totalNanos / 1e6 << " ms, output: " << outputBytes << " bytes\n";
+    out << "throughput: " << (sliceSeconds > 0 ? sliceCount / sliceSeconds : 0.0) << " slices/s\n";
+}
@@ -0,0 +1,54 @@
+#ifndef REPLAY_STATS_H
+#define REPLAY_STATS_H
+
+#include <chrono>
+#include <ostream>
+
+// 回放时统计的阶段
+enum ReplayPhase {
+    PHASE_PREPROCESS = 0,  // 读取系统参数、预分配与管理器构造
+    PHASE_TIMESTAMP = 1,   // 时间片对齐
+    PHASE_DELETE = 2,      // 删除事件
+    PHASE_WRITE = 3,       // 写入事件
+    PHASE_READ = 4,        // 读取事件（含磁头调度与输出）
+    PHASE_COUNT = 5
+};
+
+/**
+ * 离线回放的计时统计
+ *
+ * 记录每个阶段累计的墙钟时间，回放结束后输出各阶段耗时和每秒处理的时间片数。
+ */
+class ReplayStats {
+public:
+    ReplayStats();
+
+    // 开始计时
+    void begin() { phaseStart = Clock::now(); }
+
+    // 结束计时，将耗时累加到指定阶段，并以当前时刻作为下一阶段的起点
+    void end(ReplayPhase phase) {
+        Clock::time_point now = Clock::now();
+        phaseNanos[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - phaseStart).count();
+        phaseStart = now;
+    }
+
+    // 记录完成的时间片
+    void addSlice() { sliceCount++; }
+
+    /**
+     * 输出统计报告
+     * 参数 out: 输出流
+     * 参数 outputBytes: 回放期间产生的输出字节数
+     */
+    void report(std::ostream& out, size_t outputBytes) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point phaseStart;          // 当前阶段的开始时刻
+    long long phaseNanos[PHASE_COUNT];     // 每个阶段累计耗时（纳秒）
+    int sliceCount;                        // 已处理的时间片数
+};
+
+#endif // REPLAY_STATS_H
@@ -0,0 +1,79 @@
+#include "request_table.h"
+
+RequestTable::RequestTable()
+    : ring(INITIAL_RING_SIZE, -1), ringMask(INITIAL_RING_SIZE - 1), head(0), baseId(0), span(0), liveCount(0) {}
+
+ReadRequest& RequestTable::insert(int requestId, int objectId) {
+    if (span == 0) {
+        // 表为空，以该请求为新的起点
+        baseId = requestId;
+        head = 0;
+    }
+    if (requestId < baseId) {
+        // 请求ID小于起点（乱序到达），起点前移
+        int shift = baseId - requestId;
+        growRing(span + shift, shift);
+        baseId = requestId;
+        span += shift;
+    }
+    int offset = requestId - baseId;
+    if (offset >= static_cast<int>(ring.size())) {
+        growRing(offset + 1, 0);
+    }
+    if (offset >= span) {
+        span = offset + 1;
+    }
+
+    // 优先复用空闲槽位
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        ReadRequest& request = slots[slot];
+        request.requestId = requestId;
+        request.objectId = objectId;
+        request.status = REQUEST_PENDING;
+        request.progressTicket = 0;
+        request.replicaChoice = 0;
+        request.startTimeSlice = 0;
+        request.lateBound = false;
+    } else {
+        slot = static_cast<int>(slots.size());
+        slots.emplace_back(requestId, objectId);
+    }
+    ring[(head + offset) & ringMask] = slot;
+    liveCount++;
+    return slots[slot];
+}
+
+bool RequestTable::erase(int requestId) {
+    int slot = findSlot(requestId);
+    if (slot == -1) {
+        return false;
+    }
+    ring[(head + requestId - baseId) & ringMask] = -1;
+    freeSlots.push_back(slot);
+    liveCount--;
+
+    // 起点之前的请求都已移除时前移起点
+    while (span > 0 && ring[head] == -1) {
+        head = (head + 1) & ringMask;
+        baseId++;
+        span--;
+    }
+    return true;
+}
+
+void RequestTable::growRing(int size, int shift) {
+    int newSize = static_cast<int>(ring.size());
+    while (newSize < size) {
+        newSize *= 2;
+    }
+    std::vector<int> newRing(newSize, -1);
+    for (int i = 0; i < span; i++) {
+        newRing[i + shift] = ring[(head + i) & ringMask];
+    }
+    ring.swap(newRing);
+    ringMask = newSize - 1;
+    head = 0;
+}
@@ -0,0 +1,123 @@
+#ifndef REQUEST_TABLE_H
+#define REQUEST_TABLE_H
+
+#include <vector>
+#include "constants.h"
+
+// 读取请求状态
+enum RequestStatus {
+    REQUEST_PENDING,     // 等待处理
+    REQUEST_PROCESSING,  // 处理中
+    REQUEST_COMPLETED    // 已完成
+};
+
+// 单个对象最多跟踪的块数（位掩码宽度）
+static constexpr int MAX_REQUEST_BLOCKS = 16;
+static_assert(MAX_OBJECT_SIZE <= MAX_REQUEST_BLOCKS, "对象块数超出请求位掩码宽度");
+static_assert(MAX_REQUEST_BLOCKS * 2 <= 32, "每块2位的副本编号超出 replicaChoice 宽度");
+
+/**
+ * 读取请求数据结构
+ *
+ * 读取进度记录在对象上（见 ObjectReadProgress），请求只保存到达时领取的序号；
+ * 每块选择读取的副本编号按 2 位一组打包，结合对象的副本布局即可得到磁盘ID和单元位置。
+ * 记录大小固定，创建、更新和取消请求都不需要分配内存。
+ */
+struct ReadRequest {
+    int requestId;              // 请求ID
+    int objectId;               // 读取的对象ID
+    RequestStatus status;       // 请求状态
+    int progressTicket;         // 在对象读取进度中的序号
+    unsigned int replicaChoice; // 每块读取的副本编号，第i块占第 2i、2i+1 位
+    int startTimeSlice;         // 请求开始时间片
+    bool lateBound;             // 是否在其他副本上登记了软需求
+
+    ReadRequest() : requestId(0), objectId(0), status(REQUEST_PENDING), progressTicket(0), replicaChoice(0), startTimeSlice(0), lateBound(false) {}
+    ReadRequest(int reqId, int objId) : requestId(reqId), objectId(objId), status(REQUEST_PENDING), progressTicket(0), replicaChoice(0), startTimeSlice(0), lateBound(false) {}
+
+    // 第 block 块读取的副本编号
+    int getReplica(int block) const { return (replicaChoice >> (block * 2)) & 3u; }
+
+    // 设置第 block 块读取的副本编号
+    void setReplica(int block, int replicaIndex) {
+        replicaChoice = (replicaChoice & ~(3u << (block * 2))) | (static_cast<unsigned int>(replicaIndex) << (block * 2));
+    }
+};
+
+/**
+ * 按请求ID索引的请求表
+ *
+ * 请求ID按到达顺序递增，用环形数组按 (ID - 最小在途ID) 的偏移直接索引到记录槽位；
+ * 记录保存在槽位数组中，请求完成或取消后槽位进入空闲链表复用。
+ * 最小在途ID之前的请求都已移除时环形数组的起点随之前移，
+ * 因此内存只与在途请求的ID跨度有关，与请求总数无关。
+ */
+class RequestTable {
+public:
+    RequestTable();
+
+    /**
+     * 查找请求
+     * 返回值: 请求记录，不存在返回 nullptr。insert 之后之前返回的指针可能失效
+     */
+    ReadRequest* find(int requestId) {
+        int slot = findSlot(requestId);
+        return slot == -1 ? nullptr : &slots[slot];
+    }
+    const ReadRequest* find(int requestId) const {
+        int slot = findSlot(requestId);
+        return slot == -1 ? nullptr : &slots[slot];
+    }
+
+    /**
+     * 插入新请求，请求ID通常递增；小于表中最小ID时环形数组整体后移
+     * 返回值: 新请求的记录
+     */
+    ReadRequest& insert(int requestId, int objectId);
+
+    /**
+     * 移除请求，槽位回收复用
+     * 返回值: 请求是否存在
+     */
+    bool erase(int requestId);
+
+    // 表中的请求数量
+    int size() const { return liveCount; }
+
+    // 遍历表中的所有请求
+    template <typename Func>
+    void forEach(Func func) const {
+        for (int i = 0; i < span; i++) {
+            int slot = ring[(head + i) & ringMask];
+            if (slot != -1) {
+                func(slots[slot]);
+            }
+        }
+    }
+
+private:
+    static constexpr int INITIAL_RING_SIZE = 1024;
+
+    std::vector<ReadRequest> slots;  // 请求记录槽位
+    std::vector<int> freeSlots;      // 空闲槽位
+
+    std::vector<int> ring;  // 环形索引，ring[(head + id - baseId) & ringMask] 为请求id的槽位，-1表示不存在
+    int ringMask;           // 环形数组大小减一（大小为2的幂）
+    int head;               // baseId 在环形数组中的位置
+    int baseId;             // 环形数组起点对应的请求ID
+    int span;               // 从 baseId 起已使用的ID数量
+    int liveCount;          // 表中的请求数量
+
+    int findSlot(int requestId) const {
+        long long offset = static_cast<long long>(requestId) - baseId;
+        if (offset < 0 || offset >= span) {
+            return -1;
+        }
+        return ring[(head + static_cast<int>(offset)) & ringMask];
+    }
+
+    // 重建环形数组，使其至少能容纳 size 个连续ID，原有内容整体后移 shift 个位置
+    void growRing(int size, int shift);
+};
+
+#endif // REQUEST_TABLE_H
@@ -0,0 +1,44 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+
+/**
+ * 按到期时间片分桶的时间轮
+ *
+ * 桶数为最大提前量加一，到期时间片 t 的条目放在第 t % 桶数 个桶中。
+ * 每个时间片只弹出当前桶，代价与到期条目数成正比；桶的容量在复用中保留，
+ * 稳定运行后不再分配内存。条目只登记不撤销，已无效的条目由调用方在弹出时跳过。
+ */
+class TimingWheel {
+public:
+    TimingWheel() {}
+
+    /**
+     * 初始化
+     * 参数 maxDelay: 登记时到期时间片最多比当前时间片晚多少
+     */
+    void init(int maxDelay) {
+        buckets.assign(maxDelay + 1, std::vector<int>());
+    }
+
+    // 登记在时间片 slice 到期的条目
+    void add(int slice, int id) {
+        buckets[slice % buckets.size()].push_back(id);
+    }
+
+    // 弹出时间片 slice 到期的所有条目，对每个条目调用 func(id)
+    template <typename Func>
+    void popExpired(int slice, Func func) {
+        std::vector<int>& bucket = buckets[slice % buckets.size()];
+        for (int id : bucket) {
+            func(id);
+        }
+        bucket.clear();
+    }
+
+private:
+    std::vector<std::vector<int>> buckets;  // 每个桶中到期的条目
+};
+
+#endif // TIMING_WHEEL_H
@@ -0,0 +1,172 @@
+#include "trace_file.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char TRACE_FILE_MAGIC[8] = {'H', 'W', 'T', 'R', 'A', 'C', 'E', '1'};
+const char TRACE_INDEX_MAGIC[8] = {'H', 'W', 'T', 'R', 'I', 'D', 'X', '1'};
+
+// 文件尾：索引偏移、时间片数、魔数
+static constexpr size_t TRACE_FOOTER_SIZE = 2 * sizeof(uint64_t) + sizeof(TRACE_INDEX_MAGIC);
+
+TraceRecorder::TraceRecorder() : fd(-1), fileOffset(0) {
+    buffer.reserve(BUFFER_SIZE);
+}
+
+TraceRecorder::~TraceRecorder() {
+    close();
+}
+
+bool TraceRecorder::open(const char* path) {
+    close();
+    fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    fileOffset = 0;
+    sliceOffsets.clear();
+    writeRaw(TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC));
+    return true;
+}
+
+void TraceRecorder::beginSlice() {
+    sliceOffsets.push_back(fileOffset + buffer.size());
+}
+
+void TraceRecorder::flushBuffer() {
+    if (buffer.empty()) {
+        return;
+    }
+    writeRaw(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+void TraceRecorder::writeRaw(const void* data, size_t size) {
+    if (fd < 0) {
+        return;
+    }
+    const char* ptr = static_cast<const char*>(data);
+    size_t remaining = size;
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, ptr, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        ptr += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    fileOffset += size;
+}
+
+void TraceRecorder::close() {
+    if (fd < 0) {
+        return;
+    }
+    flushBuffer();
+
+    // 索引按8字节对齐，便于映射后直接访问
+    static const uint8_t padding[8] = {0};
+    size_t paddingSize = (8 - fileOffset % 8) % 8;
+    writeRaw(padding, paddingSize);
+
+    uint64_t indexOffset = fileOffset;
+    uint64_t sliceCount = sliceOffsets.size();
+    writeRaw(sliceOffsets.data(), sliceOffsets.size() * sizeof(uint64_t));
+    writeRaw(&indexOffset, sizeof(indexOffset));
+    writeRaw(&sliceCount, sizeof(sliceCount));
+    writeRaw(TRACE_INDEX_MAGIC, sizeof(TRACE_INDEX_MAGIC));
+
+    ::close(fd);
+    fd = -1;
+}
+
+BinaryTrace::BinaryTrace()
+    : data(nullptr), fileSize(0), sliceOffsets(nullptr), sliceCount(0), indexOffset(0) {}
+
+BinaryTrace::~BinaryTrace() {
+    close();
+}
+
+bool BinaryTrace::isBinaryTrace(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    char magic[sizeof(TRACE_FILE_MAGIC)];
+    bool result = ::read(fd, magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)) &&
+                  std::memcmp(magic, TRACE_FILE_MAGIC, sizeof(magic)) == 0;
+    ::close(fd);
+    return result;
+}
+
+bool BinaryTrace::open(const char* path) {
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TRACE_FILE_MAGIC) + TRACE_FOOTER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+    fileSize = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        fileSize = 0;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    madvise(mapped, fileSize, MADV_SEQUENTIAL);
+
+    // 校验文件头和文件尾
+    const uint8_t* footer = data + fileSize - TRACE_FOOTER_SIZE;
+    std::memcpy(&indexOffset, footer, sizeof(uint64_t));
+    std::memcpy(&sliceCount, footer + sizeof(uint64_t), sizeof(uint64_t));
+    bool valid = std::memcmp(data, TRACE_FILE_MAGIC, sizeof(TRACE_FILE_MAGIC)) == 0 &&
+                 std::memcmp(footer + 2 * sizeof(uint64_t), TRACE_INDEX_MAGIC, sizeof(TRACE_INDEX_MAGIC)) == 0 &&
+                 indexOffset % sizeof(uint64_t) == 0 &&
+                 indexOffset + sliceCount * sizeof(uint64_t) == fileSize - TRACE_FOOTER_SIZE;
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    sliceOffsets = reinterpret_cast<const uint64_t*>(data + indexOffset);
+    for (uint64_t i = 0; i < sliceCount; i++) {
+        if (sliceOffsets[i] < sizeof(TRACE_FILE_MAGIC) || sliceOffsets[i] > indexOffset ||
+            (i > 0 && sliceOffsets[i] < sliceOffsets[i - 1])) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryTrace::getSliceBlock(int t, const uint8_t*& begin, const uint8_t*& end) const {
+    if (t < 1 || static_cast<uint64_t>(t) > sliceCount) {
+        return false;
+    }
+    begin = data + sliceOffsets[t - 1];
+    end = data + (static_cast<uint64_t>(t) < sliceCount ? sliceOffsets[t] : indexOffset);
+    return true;
+}
+
+void BinaryTrace::close() {
+    if (data != nullptr) {
+        munmap(const_cast<uint8_t*>(data), fileSize);
+    }
+    data = nullptr;
+    fileSize = 0;
+    sliceOffsets = nullptr;
+    sliceCount = 0;
+    indexOffset = 0;
+}
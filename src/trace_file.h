@@ -0,0 +1,127 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 二进制录制文件格式（小端序）
+ *
+ *   文件头   : 魔数 "HWTRACE1"(8字节)
+ *   参数块   : T M N V G 以及三张频率表，按读取顺序依次编码
+ *   时间片块 : 每个时间片一个块，包含时间戳以及删除、写入、读取事件的所有整数
+ *   索引     : 每个时间片块相对文件开头的偏移，uint64 x 时间片数
+ *   文件尾   : 索引偏移 uint64、时间片数 uint64、魔数 "HWTRIDX1"(8字节)
+ *
+ * 所有整数都按输入协议中的读取顺序编码为 zigzag + LEB128 变长整数，
+ * 回放时可以直接在映射的内存上解码，通过索引可以直接定位任意时间片。
+ */
+
+// 录制文件魔数
+extern const char TRACE_FILE_MAGIC[8];
+extern const char TRACE_INDEX_MAGIC[8];
+
+/**
+ * 录制器，将输入扫描器读到的整数写成二进制录制文件
+ */
+class TraceRecorder {
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * 创建录制文件并写入文件头
+     * 参数 path: 文件路径
+     * 返回值: 是否成功
+     */
+    bool open(const char* path);
+
+    /**
+     * 开始一个新的时间片块，记录其偏移
+     */
+    void beginSlice();
+
+    /**
+     * 追加一个整数
+     */
+    void appendInt(int value) {
+        if (buffer.size() + 5 > buffer.capacity()) {
+            flushBuffer();
+        }
+        uint32_t encoded = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+        while (encoded >= 0x80) {
+            buffer.push_back(static_cast<uint8_t>(encoded | 0x80));
+            encoded >>= 7;
+        }
+        buffer.push_back(static_cast<uint8_t>(encoded));
+    }
+
+    /**
+     * 写入索引和文件尾并关闭文件
+     */
+    void close();
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 16;
+
+    int fd;                              // 文件描述符
+    uint64_t fileOffset;                 // 已写出的字节数
+    std::vector<uint8_t> buffer;         // 写缓冲区
+    std::vector<uint64_t> sliceOffsets;  // 每个时间片块的偏移
+
+    void flushBuffer();
+    void writeRaw(const void* data, size_t size);
+};
+
+/**
+ * 二进制录制文件，使用 mmap 映射后只读访问
+ */
+class BinaryTrace {
+public:
+    BinaryTrace();
+    ~BinaryTrace();
+
+    BinaryTrace(const BinaryTrace&) = delete;
+    BinaryTrace& operator=(const BinaryTrace&) = delete;
+
+    /**
+     * 检查文件是否为二进制录制文件
+     */
+    static bool isBinaryTrace(const char* path);
+
+    /**
+     * 映射录制文件并校验文件头、索引
+     * 返回值: 是否成功
+     */
+    bool open(const char* path);
+
+    // 获取时间片数量
+    int getSliceCount() const { return static_cast<int>(sliceCount); }
+
+    // 获取参数块的范围 [begin, end)
+    const uint8_t* getHeaderBegin() const { return data + sizeof(TRACE_FILE_MAGIC); }
+    const uint8_t* getHeaderEnd() const { return sliceCount > 0 ? data + sliceOffsets[0] : data + indexOffset; }
+
+    /**
+     * 获取第 t 个时间片块的范围（t 从1开始），无需扫描之前的时间片
+     * 参数 t: 时间片编号
+     * 参数 begin/end: 输出块的范围 [begin, end)
+     * 返回值: 时间片是否存在
+     */
+    bool getSliceBlock(int t, const uint8_t*& begin, const uint8_t*& end) const;
+
+private:
+    const uint8_t* data;          // 映射的文件内容
+    size_t fileSize;              // 文件大小
+    const uint64_t* sliceOffsets; // 索引（指向映射内存）
+    uint64_t sliceCount;          // 时间片数量
+    uint64_t indexOffset;         // 索引偏移
+
+    void close();
+};
+
+#endif // TRACE_FILE_H
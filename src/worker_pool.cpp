@@ -0,0 +1,90 @@
+#include "worker_pool.h"
+#include <immintrin.h>
+
+WorkerPool::WorkerPool(int threadCount)
+    : generation(0), nextIndex(0), activeWorkers(0), stopping(false),
+      taskEnd(0), taskFunc(nullptr), taskContext(nullptr), parkedWorkers(0) {
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        stopping.store(true, std::memory_order_relaxed);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    parkCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::dispatch(int begin, int end, TaskFunc func, void* context) {
+    // 上一批次已经通过屏障，可以安全地改写任务
+    taskEnd = end;
+    taskFunc = func;
+    taskContext = context;
+    nextIndex.store(begin, std::memory_order_relaxed);
+    activeWorkers.store(static_cast<int>(workers.size()), std::memory_order_relaxed);
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        generation.fetch_add(1, std::memory_order_release);
+        // 所有工作线程都在自旋时无需唤醒
+        wake = parkedWorkers > 0;
+    }
+    if (wake) {
+        parkCondition.notify_all();
+    }
+
+    // 调用线程也参与计算
+    runTasks();
+
+    // 屏障：等待所有工作线程完成当前批次
+    int spins = 0;
+    while (activeWorkers.load(std::memory_order_acquire) != 0) {
+        if (++spins < SPIN_LIMIT) {
+            _mm_pause();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void WorkerPool::runTasks() {
+    int index;
+    while ((index = nextIndex.fetch_add(1, std::memory_order_relaxed)) < taskEnd) {
+        taskFunc(taskContext, index);
+    }
+}
+
+void WorkerPool::workerLoop() {
+    uint64_t seen = 0;
+    while (true) {
+        // 先自旋等待新批次
+        uint64_t current = generation.load(std::memory_order_acquire);
+        for (int spins = 0; current == seen && spins < SPIN_LIMIT; spins++) {
+            _mm_pause();
+            current = generation.load(std::memory_order_acquire);
+        }
+        // 超时后挂起
+        if (current == seen) {
+            std::unique_lock<std::mutex> lock(parkMutex);
+            parkedWorkers++;
+            parkCondition.wait(lock, [&] {
+                return generation.load(std::memory_order_acquire) != seen;
+            });
+            parkedWorkers--;
+            current = generation.load(std::memory_order_acquire);
+        }
+        if (stopping.load(std::memory_order_relaxed)) {
+            return;
+        }
+        seen = current;
+
+        runTasks();
+        activeWorkers.fetch_sub(1, std::memory_order_release);
+    }
+}
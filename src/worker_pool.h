@@ -0,0 +1,80 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 常驻工作线程池，用于按磁盘并行执行每个时间片的计算
+ *
+ * 线程在启动时创建一次。每次 parallelFor 时，调用线程与工作线程一起从共享计数器领取下标，
+ * 全部完成后通过计数屏障返回。工作线程在两次任务之间先自旋等待，超时后挂起在条件变量上，
+ * 避免空闲时占用核心。任务之间不能有数据依赖，每个下标只写自己的数据，因此结果与串行执行一致。
+ */
+class WorkerPool {
+public:
+    /**
+     * 创建线程池
+     * 参数 threadCount: 参与计算的线程总数（包括调用线程），不大于1时不创建工作线程
+     */
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // 参与计算的线程总数
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    /**
+     * 对 [begin, end) 内的每个下标调用 func(i)，返回时所有调用均已完成
+     */
+    template <typename Func>
+    void parallelFor(int begin, int end, Func& func) {
+        if (workers.empty() || end - begin <= 1) {
+            for (int i = begin; i < end; i++) {
+                func(i);
+            }
+            return;
+        }
+        dispatch(begin, end, &invoke<Func>, &func);
+    }
+
+private:
+    using TaskFunc = void (*)(void*, int);
+
+    // 工作线程自旋等待的次数，超过后挂起
+    static constexpr int SPIN_LIMIT = 4096;
+
+    template <typename Func>
+    static void invoke(void* context, int index) {
+        (*static_cast<Func*>(context))(index);
+    }
+
+    std::vector<std::thread> workers;
+
+    std::atomic<uint64_t> generation;   // 任务批次编号，每次分发加一
+    std::atomic<int> nextIndex;         // 下一个待领取的下标
+    std::atomic<int> activeWorkers;     // 尚未完成当前批次的工作线程数
+    std::atomic<bool> stopping;         // 线程池正在销毁
+
+    // 当前批次的任务，在 generation 递增前写入
+    int taskEnd;
+    TaskFunc taskFunc;
+    void* taskContext;
+
+    // 挂起的工作线程等待新批次
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+    int parkedWorkers;
+
+    void dispatch(int begin, int end, TaskFunc func, void* context);
+    void runTasks();
+    void workerLoop();
+};
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,688 @@
+// 本地判题器
+//
+// 通过管道与 code_craft 进行交互，按时间片逐阶段发送录制的输入，
+// 校验选手程序的输出（副本位置、磁头动作、令牌消耗、上报的完成/取消请求），
+// 并计算请求得分。
+//
+// 用法: local_judge <trace> [--program <path>] [--quiet-child] [--verbose]
+//
+// 得分规则（与赛题一致）:
+//   请求从到达到上报完成经过 x 个时间片
+//   f(x) = 1 - 0.005x        (x <= 10)
+//          1.05 - 0.01x      (10 < x <= 105)
+//          0                 (x > 105)
+//   g(size) = (size + 1) * 0.5
+//   请求得分为 f(x) * g(size)
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const int REP_NUM = 3;
+const int FRE_PER_SLICING = 1800;
+const int EXTRA_TIME = 105;
+
+// 录制文件中一个时间片的事件
+struct SliceEvents {
+    std::vector<int> deletes;                       // 删除的对象ID
+    std::vector<std::tuple<int, int, int>> writes;  // <对象ID, 大小, 标签>
+    std::vector<std::pair<int, int>> reads;         // <请求ID, 对象ID>
+};
+
+// 录制文件
+struct Trace {
+    int T = 0, M = 0, N = 0, V = 0, G = 0;
+    std::vector<int> frequencyTables;  // 三张频率表，按输入顺序展开
+    std::vector<SliceEvents> slices;   // 下标从1开始
+};
+
+// 判题器内部的对象信息
+struct JudgeObject {
+    int size = 0;
+    int tag = 0;
+    int replicaDisk[REP_NUM] = {0, 0, 0};
+    std::vector<int> replicaUnits[REP_NUM];  // 第i个单元存储对象的第i块
+    std::vector<int> pendingRequests;        // 尚未完成的请求ID
+};
+
+// 判题器内部的请求信息
+struct JudgeRequest {
+    int objectId = 0;
+    int arrivalSlice = 0;
+    unsigned int unreadBlocks = 0;  // 仍未读取的块（位掩码）
+};
+
+// 磁头状态
+struct JudgeHead {
+    int position = 1;
+    bool lastWasRead = false;
+    int lastReadCost = 0;
+};
+
+// 简单的整数记号读取器
+class TokenReader {
+public:
+    explicit TokenReader(const std::string& text) : data(text), pos(0) {}
+
+    bool next(long long& value) {
+        for (;;) {
+            while (pos < data.size() && static_cast<unsigned char>(data[pos]) <= ' ') {
+                pos++;
+            }
+            if (pos >= data.size()) {
+                return false;
+            }
+            // 跳过非数字记号（如 "TIMESTAMP"）
+            if (data[pos] != '-' && (data[pos] < '0' || data[pos] > '9')) {
+                while (pos < data.size() && static_cast<unsigned char>(data[pos]) > ' ') {
+                    pos++;
+                }
+                continue;
+            }
+            break;
+        }
+        bool negative = false;
+        if (data[pos] == '-') {
+            negative = true;
+            pos++;
+        }
+        long long result = 0;
+        while (pos < data.size() && data[pos] >= '0' && data[pos] <= '9') {
+            result = result * 10 + (data[pos] - '0');
+            pos++;
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    int nextInt() {
+        long long value = 0;
+        if (!next(value)) {
+            throw std::runtime_error("录制文件意外结束");
+        }
+        return static_cast<int>(value);
+    }
+
+private:
+    const std::string& data;
+    size_t pos;
+};
+
+// 从管道按行读取选手输出
+class LineReader {
+public:
+    explicit LineReader(int fd) : fd(fd), start(0), end(0), buffer(1 << 16) {}
+
+    bool readLine(std::string& line) {
+        line.clear();
+        for (;;) {
+            for (size_t i = start; i < end; i++) {
+                if (buffer[i] == '\n') {
+                    line.append(buffer.data() + start, i - start);
+                    start = i + 1;
+                    if (!line.empty() && line.back() == '\r') {
+                        line.pop_back();
+                    }
+                    return true;
+                }
+            }
+            line.append(buffer.data() + start, end - start);
+            start = end = 0;
+            ssize_t bytes;
+            do {
+                bytes = ::read(fd, buffer.data(), buffer.size());
+            } while (bytes < 0 && errno == EINTR);
+            if (bytes <= 0) {
+                return !line.empty();
+            }
+            end = static_cast<size_t>(bytes);
+        }
+    }
+
+private:
+    int fd;
+    size_t start;
+    size_t end;
+    std::vector<char> buffer;
+};
+
+// 判题错误
+struct JudgeError : std::runtime_error {
+    explicit JudgeError(const std::string& message) : std::runtime_error(message) {}
+};
+
+double scoreLatency(int x) {
+    if (x <= 10) {
+        return 1.0 - 0.005 * x;
+    }
+    if (x <= EXTRA_TIME) {
+        return 1.05 - 0.01 * x;
+    }
+    return 0.0;
+}
+
+double scoreSize(int size) {
+    return (size + 1) * 0.5;
+}
+
+Trace loadTrace(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("无法打开录制文件: " + path);
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    TokenReader reader(text);
+    Trace trace;
+    trace.T = reader.nextInt();
+    trace.M = reader.nextInt();
+    trace.N = reader.nextInt();
+    trace.V = reader.nextInt();
+    trace.G = reader.nextInt();
+
+    int sliceCount = (trace.T - 1) / FRE_PER_SLICING + 1;
+    trace.frequencyTables.resize(3 * trace.M * sliceCount);
+    for (int& value : trace.frequencyTables) {
+        value = reader.nextInt();
+    }
+
+    trace.slices.resize(trace.T + EXTRA_TIME + 1);
+    for (int t = 1; t <= trace.T + EXTRA_TIME; t++) {
+        SliceEvents& slice = trace.slices[t];
+        int timestamp = reader.nextInt();
+        if (timestamp != t) {
+            throw std::runtime_error("录制文件时间片不连续: 期望 " + std::to_string(t) + " 实际 " + std::to_string(timestamp));
+        }
+        int deleteCount = reader.nextInt();
+        slice.deletes.resize(deleteCount);
+        for (int& objectId : slice.deletes) {
+            objectId = reader.nextInt();
+        }
+        int writeCount = reader.nextInt();
+        slice.writes.reserve(writeCount);
+        for (int i = 0; i < writeCount; i++) {
+            int objectId = reader.nextInt();
+            int size = reader.nextInt();
+            int tag = reader.nextInt();
+            slice.writes.emplace_back(objectId, size, tag);
+        }
+        int readCount = reader.nextInt();
+        slice.reads.reserve(readCount);
+        for (int i = 0; i < readCount; i++) {
+            int requestId = reader.nextInt();
+            int objectId = reader.nextInt();
+            slice.reads.emplace_back(requestId, objectId);
+        }
+    }
+    return trace;
+}
+
+class LocalJudge {
+public:
+    LocalJudge(const Trace& trace, bool verbose) : trace(trace), verbose(verbose) {
+        diskUnits.assign(trace.N + 1, std::vector<std::pair<int, int>>(trace.V + 1, {0, -1}));
+        heads.resize(trace.N + 1);
+    }
+
+    // 与选手程序交互直到结束，出错时抛出 JudgeError
+    void run(int toProgram, int fromProgram);
+
+    void report(std::ostream& out) const;
+
+private:
+    const Trace& trace;
+    bool verbose;
+
+    std::vector<std::vector<std::pair<int, int>>> diskUnits;  // <对象ID, 块序号>，对象ID为0表示空闲
+    std::vector<JudgeHead> heads;
+    std::unordered_map<int, JudgeObject> objects;
+    std::unordered_map<int, JudgeRequest> requests;
+
+    // 统计信息
+    double totalScore = 0.0;
+    double maxScore = 0.0;
+    long long completedCount = 0;
+    long long abortedCount = 0;
+    long long zeroScoreCount = 0;
+    long long totalLatency = 0;
+    long long requestCount = 0;
+    long long jumpCount = 0;
+    long long passCount = 0;
+    long long readCount = 0;
+    long long readTokens = 0;
+    long long usedTokens = 0;
+
+    int toProgram = -1;
+    LineReader* reader = nullptr;
+
+    void send(const std::string& text);
+    std::string expectLine(const char* what);
+    int expectInt(const char* what);
+
+    void handleDeletes(int t);
+    void handleWrites(int t);
+    void handleReads(int t);
+    void executeHead(int t, int diskId, const std::string& actions);
+    void onUnitRead(int diskId, int unit);
+};
+
+void LocalJudge::send(const std::string& text) {
+    const char* data = text.data();
+    size_t remaining = text.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(toProgram, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw JudgeError("向选手程序写入失败（程序可能已退出）");
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+}
+
+std::string LocalJudge::expectLine(const char* what) {
+    std::string line;
+    if (!reader->readLine(line)) {
+        throw JudgeError(std::string("选手程序输出提前结束，期望: ") + what);
+    }
+    return line;
+}
+
+int LocalJudge::expectInt(const char* what) {
+    std::string line = expectLine(what);
+    char* endPtr = nullptr;
+    long value = std::strtol(line.c_str(), &endPtr, 10);
+    if (endPtr == line.c_str() || *endPtr != '\0') {
+        throw JudgeError(std::string("无法解析整数 (") + what + "): \"" + line + "\"");
+    }
+    return static_cast<int>(value);
+}
+
+void LocalJudge::run(int toFd, int fromFd) {
+    toProgram = toFd;
+    LineReader lineReader(fromFd);
+    reader = &lineReader;
+
+    // 发送系统参数和频率表
+    std::string header;
+    header += std::to_string(trace.T) + " " + std::to_string(trace.M) + " " + std::to_string(trace.N) + " " +
+              std::to_string(trace.V) + " " + std::to_string(trace.G) + "\n";
+    int sliceCount = (trace.T - 1) / FRE_PER_SLICING + 1;
+    for (size_t i = 0; i < trace.frequencyTables.size(); i++) {
+        header += std::to_string(trace.frequencyTables[i]);
+        header += ((i + 1) % sliceCount == 0) ? '\n' : ' ';
+    }
+    send(header);
+    if (expectLine("OK") != "OK") {
+        throw JudgeError("初始化阶段未输出 OK");
+    }
+
+    for (int t = 1; t <= trace.T + EXTRA_TIME; t++) {
+        send("TIMESTAMP " + std::to_string(t) + "\n");
+        std::string expected = "TIMESTAMP " + std::to_string(t);
+        std::string line = expectLine("TIMESTAMP");
+        if (line != expected) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 期望 \"" + expected + "\" 实际 \"" + line + "\"");
+        }
+        handleDeletes(t);
+        handleWrites(t);
+        handleReads(t);
+    }
+    reader = nullptr;
+}
+
+void LocalJudge::handleDeletes(int t) {
+    const SliceEvents& slice = trace.slices[t];
+    std::string input = std::to_string(slice.deletes.size()) + "\n";
+    for (int objectId : slice.deletes) {
+        input += std::to_string(objectId) + "\n";
+    }
+    send(input);
+
+    // 被删除对象上未完成的请求必须全部上报取消
+    std::unordered_set<int> expectedAborts;
+    for (int objectId : slice.deletes) {
+        auto it = objects.find(objectId);
+        if (it == objects.end()) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 删除了不存在的对象 " + std::to_string(objectId));
+        }
+        for (int requestId : it->second.pendingRequests) {
+            expectedAborts.insert(requestId);
+        }
+    }
+
+    int abortCount = expectInt("取消请求数");
+    std::unordered_set<int> reported;
+    for (int i = 0; i < abortCount; i++) {
+        int requestId = expectInt("取消请求ID");
+        if (!expectedAborts.count(requestId) || !reported.insert(requestId).second) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 上报了无效的取消请求 " + std::to_string(requestId));
+        }
+    }
+    if (reported.size() != expectedAborts.size()) {
+        throw JudgeError("时间片 " + std::to_string(t) + " 漏报取消请求: 期望 " + std::to_string(expectedAborts.size()) +
+                         " 实际 " + std::to_string(reported.size()));
+    }
+    abortedCount += abortCount;
+
+    // 释放对象占用的存储单元
+    for (int objectId : slice.deletes) {
+        JudgeObject& object = objects[objectId];
+        for (int requestId : object.pendingRequests) {
+            requests.erase(requestId);
+        }
+        for (int rep = 0; rep < REP_NUM; rep++) {
+            for (int unit : object.replicaUnits[rep]) {
+                diskUnits[object.replicaDisk[rep]][unit] = {0, -1};
+            }
+        }
+        objects.erase(objectId);
+    }
+}
+
+void LocalJudge::handleWrites(int t) {
+    const SliceEvents& slice = trace.slices[t];
+    std::string input = std::to_string(slice.writes.size()) + "\n";
+    for (const auto& [objectId, size, tag] : slice.writes) {
+        input += std::to_string(objectId) + " " + std::to_string(size) + " " + std::to_string(tag) + "\n";
+    }
+    send(input);
+
+    std::string where = "时间片 " + std::to_string(t) + " 写入";
+    for (const auto& [objectId, size, tag] : slice.writes) {
+        int reportedId = expectInt("写入对象ID");
+        if (reportedId != objectId) {
+            throw JudgeError(where + " 期望对象 " + std::to_string(objectId) + " 实际 " + std::to_string(reportedId));
+        }
+        JudgeObject object;
+        object.size = size;
+        object.tag = tag;
+        for (int rep = 0; rep < REP_NUM; rep++) {
+            std::istringstream line(expectLine("副本位置"));
+            int diskId = 0;
+            if (!(line >> diskId) || diskId < 1 || diskId > trace.N) {
+                throw JudgeError(where + " 对象 " + std::to_string(objectId) + " 副本磁盘编号非法");
+            }
+            for (int other = 0; other < rep; other++) {
+                if (object.replicaDisk[other] == diskId) {
+                    throw JudgeError(where + " 对象 " + std::to_string(objectId) + " 多个副本位于同一磁盘");
+                }
+            }
+            object.replicaDisk[rep] = diskId;
+            int unit = 0;
+            while (line >> unit) {
+                if (unit < 1 || unit > trace.V || diskUnits[diskId][unit].first != 0) {
+                    throw JudgeError(where + " 对象 " + std::to_string(objectId) + " 使用了非法或已占用的单元 " +
+                                     std::to_string(diskId) + ":" + std::to_string(unit));
+                }
+                diskUnits[diskId][unit] = {objectId, static_cast<int>(object.replicaUnits[rep].size())};
+                object.replicaUnits[rep].push_back(unit);
+            }
+            if (static_cast<int>(object.replicaUnits[rep].size()) != size) {
+                throw JudgeError(where + " 对象 " + std::to_string(objectId) + " 副本单元数与对象大小不符");
+            }
+        }
+        objects[objectId] = std::move(object);
+    }
+}
+
+void LocalJudge::handleReads(int t) {
+    const SliceEvents& slice = trace.slices[t];
+    std::string input = std::to_string(slice.reads.size()) + "\n";
+    for (const auto& [requestId, objectId] : slice.reads) {
+        input += std::to_string(requestId) + " " + std::to_string(objectId) + "\n";
+    }
+    send(input);
+
+    // 登记新请求，本时间片的读取动作对它们生效
+    for (const auto& [requestId, objectId] : slice.reads) {
+        auto it = objects.find(objectId);
+        if (it == objects.end()) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 读取了不存在的对象 " + std::to_string(objectId));
+        }
+        JudgeRequest request;
+        request.objectId = objectId;
+        request.arrivalSlice = t;
+        request.unreadBlocks = (it->second.size >= 32) ? ~0u : ((1u << it->second.size) - 1);
+        requests[requestId] = request;
+        it->second.pendingRequests.push_back(requestId);
+        maxScore += scoreSize(it->second.size);
+        requestCount++;
+    }
+
+    // 执行每个磁头的动作
+    for (int diskId = 1; diskId <= trace.N; diskId++) {
+        executeHead(t, diskId, expectLine("磁头动作"));
+    }
+
+    // 校验上报完成的请求
+    int completed = expectInt("完成请求数");
+    for (int i = 0; i < completed; i++) {
+        int requestId = expectInt("完成请求ID");
+        auto it = requests.find(requestId);
+        if (it == requests.end()) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 上报了未知或重复的完成请求 " + std::to_string(requestId));
+        }
+        if (it->second.unreadBlocks != 0) {
+            throw JudgeError("时间片 " + std::to_string(t) + " 上报完成的请求 " + std::to_string(requestId) +
+                             " 仍有未读取的块");
+        }
+        JudgeObject& object = objects[it->second.objectId];
+        int latency = t - it->second.arrivalSlice;
+        double score = scoreLatency(latency) * scoreSize(object.size);
+        totalScore += score;
+        totalLatency += latency;
+        completedCount++;
+        if (score <= 0.0) {
+            zeroScoreCount++;
+        }
+        auto& pending = object.pendingRequests;
+        pending.erase(std::find(pending.begin(), pending.end(), requestId));
+        requests.erase(it);
+    }
+
+    if (verbose && t % 1000 == 0) {
+        std::cerr << "[judge] t=" << t << " score=" << totalScore << " completed=" << completedCount
+                  << " pending=" << requests.size() << std::endl;
+    }
+}
+
+void LocalJudge::executeHead(int t, int diskId, const std::string& actions) {
+    std::string where = "时间片 " + std::to_string(t) + " 磁盘 " + std::to_string(diskId);
+    JudgeHead& head = heads[diskId];
+
+    // JUMP 动作消耗整个时间片的令牌
+    if (!actions.empty() && actions[0] == 'j') {
+        int target = std::atoi(actions.c_str() + 1);
+        if (actions.size() < 3 || actions[1] != ' ' || target < 1 || target > trace.V) {
+            throw JudgeError(where + " 非法的跳跃动作: \"" + actions + "\"");
+        }
+        head.position = target;
+        head.lastWasRead = false;
+        jumpCount++;
+        usedTokens += trace.G;
+        return;
+    }
+
+    if (actions.empty() || actions.back() != '#') {
+        throw JudgeError(where + " 动作序列未以 # 结尾: \"" + actions + "\"");
+    }
+
+    int tokens = trace.G;
+    for (size_t i = 0; i + 1 < actions.size(); i++) {
+        char action = actions[i];
+        if (action == 'p') {
+            tokens -= 1;
+            head.lastWasRead = false;
+            passCount++;
+        } else if (action == 'r') {
+            // 连续读取的令牌消耗逐次衰减为上一次的0.8倍（向上取整），最低16
+            int cost = head.lastWasRead ? std::max(16, (head.lastReadCost * 4 + 4) / 5) : 64;
+            tokens -= cost;
+            head.lastWasRead = true;
+            head.lastReadCost = cost;
+            readCount++;
+            readTokens += cost;
+        } else {
+            throw JudgeError(where + " 非法的动作字符 '" + std::string(1, action) + "'");
+        }
+        if (tokens < 0) {
+            throw JudgeError(where + " 令牌超出上限 G=" + std::to_string(trace.G));
+        }
+        if (action == 'r') {
+            onUnitRead(diskId, head.position);
+        }
+        head.position = head.position % trace.V + 1;
+    }
+    usedTokens += trace.G - tokens;
+}
+
+void LocalJudge::onUnitRead(int diskId, int unit) {
+    auto [objectId, blockIndex] = diskUnits[diskId][unit];
+    if (objectId == 0) {
+        return;
+    }
+    // 读取的块对该对象所有未完成的请求都生效
+    for (int requestId : objects[objectId].pendingRequests) {
+        requests[requestId].unreadBlocks &= ~(1u << blockIndex);
+    }
+}
+
+void LocalJudge::report(std::ostream& out) const {
+    long long unfinished = static_cast<long long>(requests.size());
+    out << "score:              " << totalScore << " / " << maxScore;
+    if (maxScore > 0) {
+        out << " (" << 100.0 * totalScore / maxScore << "%)";
+    }
+    out << "\n";
+    out << "requests:           " << requestCount << "\n";
+    out << "completed:          " << completedCount << " (zero score: " << zeroScoreCount << ")\n";
+    out << "aborted:            " << abortedCount << "\n";
+    out << "unfinished:         " << unfinished << "\n";
+    out << "avg latency:        " << (completedCount > 0 ? static_cast<double>(totalLatency) / completedCount : 0.0)
+        << " slices\n";
+    out << "head actions:       jump " << jumpCount << ", pass " << passCount << ", read " << readCount << "\n";
+    out << "tokens used:        " << usedTokens << " (read " << readTokens << ")\n";
+}
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " <trace> [--program <path>] [--quiet-child] [--verbose]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string tracePath;
+    std::string programPath = "./code_craft";
+    bool quietChild = false;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--program") == 0 && i + 1 < argc) {
+            programPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--quiet-child") == 0) {
+            quietChild = true;
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (tracePath.empty() && argv[i][0] != '-') {
+            tracePath = argv[i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (tracePath.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    Trace trace;
+    try {
+        trace = loadTrace(tracePath);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    // 建立与选手程序之间的双向管道
+    int toChild[2];
+    int fromChild[2];
+    if (pipe(toChild) != 0 || pipe(fromChild) != 0) {
+        std::perror("pipe");
+        return 2;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return 2;
+    }
+    if (pid == 0) {
+        dup2(toChild[0], STDIN_FILENO);
+        dup2(fromChild[1], STDOUT_FILENO);
+        if (quietChild) {
+            int devNull = open("/dev/null", O_WRONLY);
+            if (devNull >= 0) {
+                dup2(devNull, STDERR_FILENO);
+            }
+        }
+        close(toChild[0]);
+        close(toChild[1]);
+        close(fromChild[0]);
+        close(fromChild[1]);
+        execl(programPath.c_str(), programPath.c_str(), static_cast<char*>(nullptr));
+        std::perror("execl");
+        _exit(127);
+    }
+    close(toChild[0]);
+    close(fromChild[1]);
+
+    LocalJudge judge(trace, verbose);
+    int exitCode = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        judge.run(toChild[1], fromChild[0]);
+    } catch (const std::exception& e) {
+        std::cerr << "判题失败: " << e.what() << std::endl;
+        exitCode = 1;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    close(toChild[1]);
+    close(fromChild[0]);
+    if (exitCode != 0) {
+        kill(pid, SIGKILL);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (exitCode == 0 && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+        std::cerr << "选手程序异常退出" << std::endl;
+        exitCode = 1;
+    }
+
+    judge.report(std::cout);
+    std::cout << "elapsed:            " << elapsed << " s\n";
+    return exitCode;
+}
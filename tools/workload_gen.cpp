@@ -0,0 +1,400 @@
+// 合成负载生成器
+//
+// 按给定的系统参数和分布参数生成一份完整的判题输入（与标准输入格式一致），
+// 包括三张频率表以及 T + 105 个时间片的删除、写入、读取事件。
+// 频率表由生成的事件统计得到，因此与事件流严格一致。
+//
+// 用法: workload_gen [选项] > trace.txt
+//   --T <n>             时间片数（默认 86400）
+//   --M <n>             标签数（默认 16）
+//   --N <n>             磁盘数（默认 10）
+//   --V <n>             每个磁盘的存储单元数（默认 5792）
+//   --G <n>             每个时间片的令牌数（默认 350）
+//   --seed <n>          随机种子（默认 1）
+//   --fill <f>          目标占用率，存活对象三副本占总容量的比例（默认 0.6）
+//   --write-rate <f>    每个时间片平均写入对象数（默认根据占用率在前 1/4 时间内写满）
+//   --read-rate <f>     每个时间片平均读取请求数（默认 10）
+//   --max-size <n>      对象最大大小，1 到 5（默认 5）
+//   --size-skew <f>     对象大小分布偏斜，P(s) 正比于 s^-skew，0 为均匀（默认 0）
+//   --tag-skew <f>      写入标签的 Zipf 偏斜，0 为均匀（默认 0）
+//   --hot-skew <f>      读取标签的 Zipf 偏斜（默认 1.0）
+//   --phase-length <n>  热点标签轮换的周期（时间片数，默认 1800）
+//   --burst-prob <f>    每个时间片发生批量删除的概率（默认 0）
+//   --burst-fraction <f>批量删除时删除某个标签存活对象的比例（默认 0.3）
+//   --output <path>     输出文件（默认标准输出）
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int FRE_PER_SLICING = 1800;
+const int EXTRA_TIME = 105;
+const int REP_NUM = 3;
+const int MAX_OBJECT_SIZE = 5;
+
+// 生成参数
+struct Options {
+    int T = 86400;
+    int M = 16;
+    int N = 10;
+    int V = 5792;
+    int G = 350;
+    unsigned long long seed = 1;
+    double fill = 0.6;
+    double writeRate = -1.0;
+    double readRate = 10.0;
+    int maxSize = MAX_OBJECT_SIZE;
+    double sizeSkew = 0.0;
+    double tagSkew = 0.0;
+    double hotSkew = 1.0;
+    int phaseLength = FRE_PER_SLICING;
+    double burstProb = 0.0;
+    double burstFraction = 0.3;
+    const char* outputPath = nullptr;
+};
+
+// 存活对象
+struct LiveObject {
+    int size;
+    int tag;
+    int indexInTag;  // 在所属标签对象列表中的位置
+};
+
+// 按权重离散采样
+class WeightedSampler {
+public:
+    WeightedSampler() = default;
+
+    explicit WeightedSampler(const std::vector<double>& weights) {
+        cumulative.resize(weights.size());
+        double total = 0.0;
+        for (size_t i = 0; i < weights.size(); i++) {
+            total += weights[i];
+            cumulative[i] = total;
+        }
+    }
+
+    // 返回下标；available 为false的下标会被跳过（全部不可用时返回-1）
+    template <typename Rng, typename Available>
+    int sample(Rng& rng, Available available) const {
+        if (cumulative.empty() || cumulative.back() <= 0.0) {
+            return -1;
+        }
+        std::uniform_real_distribution<double> uniform(0.0, cumulative.back());
+        for (int attempt = 0; attempt < 16; attempt++) {
+            size_t index = std::upper_bound(cumulative.begin(), cumulative.end(), uniform(rng)) - cumulative.begin();
+            index = std::min(index, cumulative.size() - 1);
+            if (available(static_cast<int>(index))) {
+                return static_cast<int>(index);
+            }
+        }
+        for (size_t i = 0; i < cumulative.size(); i++) {
+            if (available(static_cast<int>(i))) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+private:
+    std::vector<double> cumulative;
+};
+
+std::vector<double> zipfWeights(int count, double skew) {
+    std::vector<double> weights(count);
+    for (int i = 0; i < count; i++) {
+        weights[i] = 1.0 / std::pow(i + 1, skew);
+    }
+    return weights;
+}
+
+class WorkloadGenerator {
+public:
+    explicit WorkloadGenerator(const Options& options)
+        : opt(options), rng(options.seed), sliceCount((options.T - 1) / FRE_PER_SLICING + 1) {
+        freDelete.assign(opt.M + 1, std::vector<long long>(sliceCount + 1, 0));
+        freWrite.assign(opt.M + 1, std::vector<long long>(sliceCount + 1, 0));
+        freRead.assign(opt.M + 1, std::vector<long long>(sliceCount + 1, 0));
+        tagObjects.resize(opt.M + 1);
+
+        // 对象大小分布：P(s) 正比于 s^-skew
+        std::vector<double> sizeWeights(opt.maxSize);
+        for (int s = 1; s <= opt.maxSize; s++) {
+            sizeWeights[s - 1] = 1.0 / std::pow(s, opt.sizeSkew);
+        }
+        sizeSampler = WeightedSampler(sizeWeights);
+        writeTagSampler = WeightedSampler(zipfWeights(opt.M, opt.tagSkew));
+        readTagSampler = WeightedSampler(zipfWeights(opt.M, opt.hotSkew));
+
+        // 目标存活单元数（单副本）
+        targetUnits = static_cast<long long>(opt.fill * opt.N * opt.V / REP_NUM);
+        double meanSize = 0.0;
+        double totalWeight = 0.0;
+        for (int s = 1; s <= opt.maxSize; s++) {
+            meanSize += s * sizeWeights[s - 1];
+            totalWeight += sizeWeights[s - 1];
+        }
+        meanSize /= totalWeight;
+        if (opt.writeRate < 0) {
+            // 默认在前1/4的时间内写满目标容量，之后写入与删除大致平衡
+            opt.writeRate = std::max(0.1, targetUnits / meanSize / std::max(1.0, opt.T / 4.0));
+        }
+    }
+
+    // 生成所有事件并返回完整输入文本
+    std::string generate();
+
+private:
+    Options opt;
+    std::mt19937_64 rng;
+    int sliceCount;
+    long long targetUnits;
+    long long liveUnits = 0;
+
+    WeightedSampler sizeSampler;
+    WeightedSampler writeTagSampler;
+    WeightedSampler readTagSampler;
+
+    std::vector<std::vector<long long>> freDelete;
+    std::vector<std::vector<long long>> freWrite;
+    std::vector<std::vector<long long>> freRead;
+
+    std::vector<LiveObject> objects;          // 对象ID -> 对象（size为0表示不存在）
+    std::vector<std::vector<int>> tagObjects; // 每个标签的存活对象ID
+    int nextObjectId = 1;
+    int nextRequestId = 1;
+
+    int poisson(double mean) {
+        if (mean <= 0) {
+            return 0;
+        }
+        std::poisson_distribution<int> distribution(mean);
+        return distribution(rng);
+    }
+
+    // 当前阶段中排名为rank的热点标签
+    int hotTag(int rank, int t) const {
+        int phase = (t - 1) / std::max(1, opt.phaseLength);
+        return (rank + phase * 5) % opt.M + 1;
+    }
+
+    void removeObject(int objectId, int slice, std::vector<int>& deletes);
+    int randomObjectOfTag(int tag);
+};
+
+void WorkloadGenerator::removeObject(int objectId, int slice, std::vector<int>& deletes) {
+    LiveObject& object = objects[objectId];
+    std::vector<int>& list = tagObjects[object.tag];
+    int lastId = list.back();
+    list[object.indexInTag] = lastId;
+    objects[lastId].indexInTag = object.indexInTag;
+    list.pop_back();
+
+    liveUnits -= object.size;
+    freDelete[object.tag][slice] += object.size;
+    object.size = 0;
+    deletes.push_back(objectId);
+}
+
+int WorkloadGenerator::randomObjectOfTag(int tag) {
+    const std::vector<int>& list = tagObjects[tag];
+    std::uniform_int_distribution<size_t> pick(0, list.size() - 1);
+    return list[pick(rng)];
+}
+
+std::string WorkloadGenerator::generate() {
+    std::string events;
+    events.reserve(static_cast<size_t>(opt.T) * 64);
+    objects.resize(1);
+
+    std::vector<int> deletes;
+    std::vector<int> writes;
+    std::vector<std::pair<int, int>> reads;
+    std::vector<std::pair<int, int>> newObjects;  // <大小, 标签>
+    char line[64];
+
+    for (int t = 1; t <= opt.T + EXTRA_TIME; t++) {
+        int slice = (t - 1) / FRE_PER_SLICING + 1;
+        deletes.clear();
+        writes.clear();
+        reads.clear();
+
+        if (t <= opt.T) {
+            // 批量删除：删除某个标签的一部分对象
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            if (opt.burstProb > 0 && uniform(rng) < opt.burstProb) {
+                std::uniform_int_distribution<int> pickTag(1, opt.M);
+                int tag = pickTag(rng);
+                int count = static_cast<int>(tagObjects[tag].size() * opt.burstFraction);
+                for (int i = 0; i < count && !tagObjects[tag].empty(); i++) {
+                    removeObject(randomObjectOfTag(tag), slice, deletes);
+                }
+            }
+
+            // 写入新对象，超过目标占用率时先删除随机的已有对象腾出空间
+            // （删除在写入之前处理，所以不能删除本时间片写入的对象）
+            int writeCount = poisson(opt.writeRate);
+            newObjects.clear();
+            long long newUnits = 0;
+            for (int i = 0; i < writeCount; i++) {
+                int size = sizeSampler.sample(rng, [](int) { return true; }) + 1;
+                int tag = writeTagSampler.sample(rng, [](int) { return true; }) + 1;
+                newObjects.push_back({size, tag});
+                newUnits += size;
+            }
+            while (liveUnits + newUnits > targetUnits && liveUnits > 0) {
+                int victimTag = writeTagSampler.sample(rng, [this](int index) {
+                    return !tagObjects[index + 1].empty();
+                }) + 1;
+                removeObject(randomObjectOfTag(victimTag), slice, deletes);
+            }
+            for (const auto& [size, tag] : newObjects) {
+                int objectId = nextObjectId++;
+                objects.push_back({size, tag, static_cast<int>(tagObjects[tag].size())});
+                tagObjects[tag].push_back(objectId);
+                liveUnits += size;
+                freWrite[tag][slice] += size;
+                writes.push_back(objectId);
+            }
+
+            // 读取请求：热点标签随阶段轮换
+            int readCount = liveUnits > 0 ? poisson(opt.readRate) : 0;
+            for (int i = 0; i < readCount; i++) {
+                int rank = readTagSampler.sample(rng, [this, t](int index) {
+                    return !tagObjects[hotTag(index, t)].empty();
+                });
+                if (rank < 0) {
+                    break;
+                }
+                int tag = hotTag(rank, t);
+                int objectId = randomObjectOfTag(tag);
+                freRead[tag][slice] += objects[objectId].size;
+                reads.push_back({nextRequestId++, objectId});
+            }
+        }
+
+        // 输出本时间片事件
+        std::snprintf(line, sizeof(line), "TIMESTAMP %d\n%zu\n", t, deletes.size());
+        events += line;
+        for (int objectId : deletes) {
+            std::snprintf(line, sizeof(line), "%d\n", objectId);
+            events += line;
+        }
+        std::snprintf(line, sizeof(line), "%zu\n", writes.size());
+        events += line;
+        for (int objectId : writes) {
+            std::snprintf(line, sizeof(line), "%d %d %d\n", objectId, objects[objectId].size, objects[objectId].tag);
+            events += line;
+        }
+        std::snprintf(line, sizeof(line), "%zu\n", reads.size());
+        events += line;
+        for (const auto& [requestId, objectId] : reads) {
+            std::snprintf(line, sizeof(line), "%d %d\n", requestId, objectId);
+            events += line;
+        }
+    }
+
+    // 系统参数和频率表放在事件之前
+    std::string output;
+    output.reserve(events.size() + static_cast<size_t>(3 * opt.M * sliceCount) * 8 + 64);
+    std::snprintf(line, sizeof(line), "%d %d %d %d %d\n", opt.T, opt.M, opt.N, opt.V, opt.G);
+    output += line;
+    for (const auto* table : {&freDelete, &freWrite, &freRead}) {
+        for (int tag = 1; tag <= opt.M; tag++) {
+            for (int j = 1; j <= sliceCount; j++) {
+                std::snprintf(line, sizeof(line), j == sliceCount ? "%lld\n" : "%lld ", (*table)[tag][j]);
+                output += line;
+            }
+        }
+    }
+    output += events;
+    return output;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program
+              << " [--T n] [--M n] [--N n] [--V n] [--G n] [--seed n] [--fill f] [--write-rate f]"
+                 " [--read-rate f] [--max-size n] [--size-skew f] [--tag-skew f] [--hot-skew f]"
+                 " [--phase-length n] [--burst-prob f] [--burst-fraction f] [--output path]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        const char* name = argv[i];
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(name, "--T") == 0) {
+            opt.T = std::atoi(value);
+        } else if (std::strcmp(name, "--M") == 0) {
+            opt.M = std::atoi(value);
+        } else if (std::strcmp(name, "--N") == 0) {
+            opt.N = std::atoi(value);
+        } else if (std::strcmp(name, "--V") == 0) {
+            opt.V = std::atoi(value);
+        } else if (std::strcmp(name, "--G") == 0) {
+            opt.G = std::atoi(value);
+        } else if (std::strcmp(name, "--seed") == 0) {
+            opt.seed = std::strtoull(value, nullptr, 10);
+        } else if (std::strcmp(name, "--fill") == 0) {
+            opt.fill = std::atof(value);
+        } else if (std::strcmp(name, "--write-rate") == 0) {
+            opt.writeRate = std::atof(value);
+        } else if (std::strcmp(name, "--read-rate") == 0) {
+            opt.readRate = std::atof(value);
+        } else if (std::strcmp(name, "--max-size") == 0) {
+            opt.maxSize = std::atoi(value);
+        } else if (std::strcmp(name, "--size-skew") == 0) {
+            opt.sizeSkew = std::atof(value);
+        } else if (std::strcmp(name, "--tag-skew") == 0) {
+            opt.tagSkew = std::atof(value);
+        } else if (std::strcmp(name, "--hot-skew") == 0) {
+            opt.hotSkew = std::atof(value);
+        } else if (std::strcmp(name, "--phase-length") == 0) {
+            opt.phaseLength = std::atoi(value);
+        } else if (std::strcmp(name, "--burst-prob") == 0) {
+            opt.burstProb = std::atof(value);
+        } else if (std::strcmp(name, "--burst-fraction") == 0) {
+            opt.burstFraction = std::atof(value);
+        } else if (std::strcmp(name, "--output") == 0) {
+            opt.outputPath = value;
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (opt.T < 1 || opt.M < 1 || opt.N < REP_NUM || opt.V < 1 || opt.G < 1 ||
+        opt.maxSize < 1 || opt.maxSize > MAX_OBJECT_SIZE ||
+        opt.fill <= 0 || opt.fill > 1) {
+        std::cerr << "参数非法" << std::endl;
+        return 2;
+    }
+
+    WorkloadGenerator generator(opt);
+    std::string output = generator.generate();
+
+    FILE* file = opt.outputPath != nullptr ? std::fopen(opt.outputPath, "wb") : stdout;
+    if (file == nullptr) {
+        std::cerr << "无法创建输出文件: " << opt.outputPath << std::endl;
+        return 1;
+    }
+    std::fwrite(output.data(), 1, output.size(), file);
+    if (file != stdout) {
+        std::fclose(file);
+    }
+    return 0;
+}